@@ -0,0 +1,68 @@
+﻿#ifndef __ATOMICPOSSIBLECHANGESTATUS_HPP__
+#define __ATOMICPOSSIBLECHANGESTATUS_HPP__
+#include "PossibleChangeStatus.hpp"
+#include <atomic>
+
+// 複数のスレッドから同時に加減算できるPossibleChangeStatus
+// 現在値のみをstd::atomicで保持し、加減算は比較交換のループで最大値と最小値の範囲に収めながら行うため、ロックを使用しない
+template<typename T, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
+class AtomicPossibleChangeStatus {
+private:
+	std::atomic<T> Current;
+	T Maximum, Minimum;
+	// 現在値を書き換える。戻り値は書き換える前の値
+	template<class Function>
+	T Update(Function&& Calc) noexcept {
+		T Before = this->Current.load(std::memory_order_relaxed);
+		while (!this->Current.compare_exchange_weak(Before, Calc(Before), std::memory_order_acq_rel, std::memory_order_relaxed));
+		return Before;
+	}
+	static T CheckedClamp(const T Current, const T Max, const T Min) {
+		if (Max < Min) throw std::runtime_error("maximum must be larger than minimum.");
+		return standard::clamp(Current, Min, Max);
+	}
+public:
+	AtomicPossibleChangeStatus(const T Max) : AtomicPossibleChangeStatus(Max, Max) {}
+	AtomicPossibleChangeStatus(const T Current, const T MaxStatus, const T MinStatus = 0)
+		: Current(CheckedClamp(Current, MaxStatus, MinStatus)), Maximum(MaxStatus), Minimum(MinStatus) {}
+	AtomicPossibleChangeStatus(const PossibleChangeStatus<T>& Status) : AtomicPossibleChangeStatus(Status.Get(), Status.GetMax(), Status.GetMin()) {}
+	AtomicPossibleChangeStatus(const AtomicPossibleChangeStatus&) = delete;
+	AtomicPossibleChangeStatus& operator = (const AtomicPossibleChangeStatus&) = delete;
+	// 現在値を取得する
+	T Get() const noexcept { return this->Current.load(std::memory_order_acquire); }
+	T operator * () const noexcept { return this->Get(); }
+	// 最大値を取得する
+	T GetMax() const noexcept { return this->Maximum; }
+	// 最小値を取得する
+	T GetMin() const noexcept { return this->Minimum; }
+	// 最小値であるかを判定する
+	bool IsMin() const noexcept { return this->Get() == this->Minimum; }
+	// 最大値であるかを判定する
+	bool IsMax() const noexcept { return this->Get() == this->Maximum; }
+	// 現在値をPossibleChangeStatusとして取得する
+	PossibleChangeStatus<T> Load() const noexcept { return PossibleChangeStatus<T>(this->Get(), this->Maximum, this->Minimum); }
+	// 現在値を指定された値に変更する(最大値と最小値の範囲に収められる)
+	void Store(const T Num) noexcept { this->Current.store(standard::clamp(Num, this->Minimum, this->Maximum), std::memory_order_release); }
+	// 加算する
+	// 引　数 : 加算値
+	// 戻り値 : 実際に加算された値
+	T Add(const T Num) noexcept {
+		const T Before = this->Update([this, Num](const T Cur) { return standard::clamp(standard::saturating_add(Cur, Num), this->Minimum, this->Maximum); });
+		const T After = standard::clamp(standard::saturating_add(Before, Num), this->Minimum, this->Maximum);
+		STATUS_INSTRUMENT_MUTATION(this, Instrumentation::StatKind::AtomicStatus, Before, After, standard::saturating_add(Before, Num), this->Maximum, this->Minimum);
+		return After - Before;
+	}
+	// 減算する
+	// 第１引数 : 減算値
+	// 第２引数 : この呼び出しによって最小値になった場合にtrueが設定される(不要な場合はnullptr)
+	//            既に最小値だった場合はfalseになるため、同時に複数のスレッドから減算されても最小値になったことを検知するのは１スレッドのみとなる
+	// 戻り値　 : 実際に減算された値
+	T Subtract(const T Num, bool* ReachedMin = nullptr) noexcept {
+		const T Before = this->Update([this, Num](const T Cur) { return standard::clamp(standard::saturating_sub(Cur, Num), this->Minimum, this->Maximum); });
+		const T After = standard::clamp(standard::saturating_sub(Before, Num), this->Minimum, this->Maximum);
+		STATUS_INSTRUMENT_MUTATION(this, Instrumentation::StatKind::AtomicStatus, Before, After, standard::saturating_sub(Before, Num), this->Maximum, this->Minimum);
+		if (ReachedMin != nullptr) *ReachedMin = Before != this->Minimum && After == this->Minimum;
+		return Before - After;
+	}
+};
+#endif
@@ -0,0 +1,178 @@
+﻿#ifndef __BATTLESIMULATOR_HPP__
+#define __BATTLESIMULATOR_HPP__
+#include "PossibleChangeStatus.hpp"
+#include "SpeedManager.hpp"
+#include "TurnScheduler.hpp"
+#include "DamageCalculation.hpp"
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <algorithm>
+#include <limits>
+
+// シミュレーションに参加するキャラクター
+struct SimulationUnit {
+	PossibleChangeStatus<int> HP;					// ＨＰ
+	UseDamageCalculationParameter<int> Attack;		// 攻撃力
+	UseDamageCalculationParameter<int> Defence;		// 守備力
+	SpeedManager<int> Speed;						// 素早さ
+	ElementInfo Elem;								// 属性
+	int SkillBasePower;								// 使用する技の基本攻撃力
+	ElementInfo SkillElement;						// 使用する技の属性
+};
+
+// シミュレーション結果
+struct SimulationResult {
+	std::uint64_t TeamAWin;						// チームＡの勝利数
+	std::uint64_t TeamBWin;						// チームＢの勝利数
+	std::uint64_t Draw;							// 最大ラウンド数までに決着しなかった数
+	std::vector<std::uint64_t> RoundHistogram;	// 決着までのラウンド数毎の戦闘数(添字がラウンド数)
+};
+
+/*
+チームＡとチームＢの戦闘を多数回シミュレーションするクラス
+各ラウンドでSpeedManagerの行動順の基準値が大きい順に(TurnSchedulerで)行動し、生存している相手からランダムに１体を選んで技で攻撃する
+ダメージはDamageCalculation::CalcDamage、属性の倍率はElementAdvantageTableを使用する
+
+戦闘はスレッド毎の担当範囲から一定数ずつ取り出して実行し、自分の範囲が空になったスレッドは他のスレッドの範囲から取り出す(ワークスティーリング)
+乱数は戦闘の通し番号毎に独立したCounterBasedRandomの系列を使用するため、同じシードであればスレッド数に関係なく結果は一致する
+結果は各スレッドで集計した後、アトミック変数への加算でまとめる
+*/
+class BattleSimulator {
+public:
+	// Simulateで使用する作業領域
+	struct Workspace {
+		std::vector<SimulationUnit> Units;
+		TurnScheduler<int> Scheduler{ 0, 0, 0 };
+		std::vector<size_t> Alive;
+	};
+private:
+	static constexpr std::uint64_t ChunkSize = 64;
+	struct alignas(64) WorkRange {
+		std::atomic<std::uint64_t> Next;
+		std::uint64_t End;
+	};
+	// 破棄時に全てのスレッドを待機する
+	struct ThreadJoiner {
+		std::vector<std::thread>& Threads;
+		~ThreadJoiner() {
+			for (std::thread& t : this->Threads) if (t.joinable()) t.join();
+		}
+	};
+	std::vector<SimulationUnit> TeamA, TeamB;
+	unsigned int MaxRound;
+	int SpeedMaxAddPoint, SpeedMinAddPoint;
+	// 範囲からChunkSize個の戦闘を取り出す
+	static bool TakeChunk(WorkRange& Range, std::uint64_t& Begin, std::uint64_t& End) noexcept {
+		if (Range.Next.load(std::memory_order_relaxed) >= Range.End) return false;
+		Begin = Range.Next.fetch_add(ChunkSize, std::memory_order_relaxed);
+		if (Begin >= Range.End) return false;
+		End = std::min(Begin + ChunkSize, Range.End);
+		return true;
+	}
+public:
+	// 第１引数：チームＡのキャラクター
+	// 第２引数：チームＢのキャラクター
+	// 第３引数：１回の戦闘の最大ラウンド数
+	// 第４引数：素早さに加算する乱数の最大値
+	// 第５引数：素早さに加算する乱数の最小値
+	BattleSimulator(std::vector<SimulationUnit> TeamA, std::vector<SimulationUnit> TeamB, const unsigned int MaxRound = 100,
+		const int SpeedMaxAddPoint = 0, const int SpeedMinAddPoint = 0)
+		: TeamA(std::move(TeamA)), TeamB(std::move(TeamB)), MaxRound(MaxRound), SpeedMaxAddPoint(SpeedMaxAddPoint), SpeedMinAddPoint(SpeedMinAddPoint) {
+		if (this->TeamA.empty() || this->TeamB.empty()) throw std::runtime_error("both teams need at least one unit.");
+		if (SpeedMaxAddPoint < SpeedMinAddPoint) throw std::runtime_error("SpeedMaxAddPoint must be larger than SpeedMinAddPoint.");
+	}
+	// １回の戦闘をシミュレーションする
+	// 第１引数：乱数生成器
+	// 第２引数：作業領域(スレッド毎に使い回す)
+	// 第３引数：勝者の出力先(0:チームＡ、1:チームＢ、2:引き分け)
+	// 戻り値　：決着までのラウンド数(最初から一方のチームが全員戦闘不能の場合は0)
+	unsigned int Simulate(const CounterBasedRandom& RandEngine, Workspace& Work, unsigned int& Winner) const {
+		const size_t TeamANum = this->TeamA.size();
+		Work.Units.assign(this->TeamA.begin(), this->TeamA.end());
+		Work.Units.insert(Work.Units.end(), this->TeamB.begin(), this->TeamB.end());
+		const size_t UnitNum = Work.Units.size();
+		// 行動順はTurnSchedulerで決める(ラウンド数・キャラクター番号を乱数のカウンター・ストリームとする)
+		// 最初からＨＰが最小値のキャラクターは戦闘不能として数えず、行動対象からも外す
+		Work.Scheduler.Clear(RandEngine.GetSeed(), this->SpeedMaxAddPoint, this->SpeedMinAddPoint);
+		size_t AliveNum[2] = {};
+		for (size_t i = 0; i < UnitNum; i++) {
+			Work.Scheduler.Add(Work.Units[i].Speed);
+			if (!Work.Units[i].HP.IsMin()) AliveNum[i < TeamANum ? 0 : 1]++;
+			else Work.Scheduler.Remove(i);
+		}
+		if (AliveNum[0] == 0 || AliveNum[1] == 0) {
+			Winner = AliveNum[0] != 0 ? 0 : AliveNum[1] != 0 ? 1 : 2;
+			return 0;
+		}
+		for (unsigned int Round = 1; Round <= this->MaxRound; Round++) {
+			Work.Scheduler.StartRound();
+			for (size_t Actor = Work.Scheduler.Next(); Actor != std::numeric_limits<size_t>::max(); Actor = Work.Scheduler.Next()) {
+				const SimulationUnit& Attacker = Work.Units[Actor];
+				const bool IsTeamA = Actor < TeamANum;
+				const size_t Begin = IsTeamA ? TeamANum : 0, End = IsTeamA ? UnitNum : TeamANum;
+				Work.Alive.clear();
+				for (size_t i = Begin; i < End; i++) if (!Work.Units[i].HP.IsMin()) Work.Alive.push_back(i);
+				if (Work.Alive.empty()) continue;
+				const size_t Target = Work.Alive[RandEngine.Generate<size_t>(Round, UnitNum + Actor, 0, Work.Alive.size() - 1)];
+				SimulationUnit& Defender = Work.Units[Target];
+				Defender.HP -= DamageCalculation::CalcDamage(*Attacker.Attack, Attacker.SkillBasePower, *Defender.Defence,
+					ElementAdvantageTable.GetAdvantage(Defender.Elem, Attacker.SkillElement));
+				if (!Defender.HP.IsMin()) continue;
+				// 戦闘不能になったキャラクターは、このラウンドでまだ行動していなくても以降は行動しない
+				Work.Scheduler.Remove(Target);
+				if (--AliveNum[IsTeamA ? 1 : 0] == 0) {
+					Winner = IsTeamA ? 0 : 1;
+					return Round;
+				}
+			}
+		}
+		Winner = 2;
+		return this->MaxRound;
+	}
+	// 戦闘をシミュレーションする
+	// 第１引数：戦闘の回数
+	// 第２引数：乱数のシード
+	// 第３引数：使用するスレッド数(0の場合はハードウェアのスレッド数)
+	SimulationResult Run(const std::uint64_t BattleNum, const std::uint64_t Seed, unsigned int ThreadNum = 0) const {
+		if (ThreadNum == 0) ThreadNum = std::max(1u, std::thread::hardware_concurrency());
+		const std::unique_ptr<WorkRange[]> Ranges(new WorkRange[ThreadNum]);
+		for (unsigned int i = 0; i < ThreadNum; i++) {
+			Ranges[i].Next.store(BattleNum * i / ThreadNum, std::memory_order_relaxed);
+			Ranges[i].End = BattleNum * (i + 1) / ThreadNum;
+		}
+		std::atomic<std::uint64_t> Total[3] = {};
+		std::vector<std::atomic<std::uint64_t>> Histogram(this->MaxRound + 1);
+		const auto Worker = [this, &Ranges, ThreadNum, Seed, &Total, &Histogram](const unsigned int Id) {
+			Workspace Work;
+			std::uint64_t LocalTotal[3] = {};
+			std::vector<std::uint64_t> LocalHistogram(this->MaxRound + 1, 0);
+			for (unsigned int Offset = 0; Offset < ThreadNum; Offset++) {
+				WorkRange& Range = Ranges[(Id + Offset) % ThreadNum];
+				std::uint64_t Begin, End;
+				while (TakeChunk(Range, Begin, End)) {
+					for (std::uint64_t Battle = Begin; Battle < End; Battle++) {
+						unsigned int Winner;
+						const unsigned int Round = this->Simulate(CounterBasedRandom(CounterBasedRandom::Mix(Seed ^ CounterBasedRandom::Mix(Battle))), Work, Winner);
+						LocalTotal[Winner]++;
+						if (Winner != 2) LocalHistogram[Round]++;
+					}
+				}
+			}
+			for (size_t i = 0; i < 3; i++) Total[i].fetch_add(LocalTotal[i], std::memory_order_relaxed);
+			for (size_t i = 0; i < LocalHistogram.size(); i++) if (LocalHistogram[i] != 0) Histogram[i].fetch_add(LocalHistogram[i], std::memory_order_relaxed);
+		};
+		std::vector<std::thread> Threads;
+		{
+			// スレッドの起動やWorker(0)で例外が投げられた場合も、起動済みのスレッドを待ってから抜ける
+			const ThreadJoiner Joiner{ Threads };
+			for (unsigned int i = 1; i < ThreadNum; i++) Threads.emplace_back(Worker, i);
+			Worker(0);
+		}
+		SimulationResult Result{ Total[0].load(), Total[1].load(), Total[2].load(), std::vector<std::uint64_t>(Histogram.size()) };
+		for (size_t i = 0; i < Histogram.size(); i++) Result.RoundHistogram[i] = Histogram[i].load();
+		return Result;
+	}
+};
+#endif
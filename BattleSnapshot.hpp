@@ -0,0 +1,183 @@
+﻿#ifndef __BATTLESNAPSHOT_HPP__
+#define __BATTLESNAPSHOT_HPP__
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <stdexcept>
+
+class BattleSnapshot;
+
+namespace standard {
+	namespace internal {
+		// BattleSnapshot::Registerで使用する。RegisterState(BattleSnapshot&)メンバ関数を持つかを判定する
+		template<class T, class = void>
+		struct has_register_state : std::false_type {};
+		template<class T>
+		struct has_register_state<T, std::void_t<decltype(std::declval<T&>().RegisterState(std::declval<BattleSnapshot&>()))>> : std::true_type {};
+	}
+}
+
+/*
+戦闘状態のスナップショットを取るクラス
+PossibleChangeStatus、UseDamageCalculationParameter、LevelManager、乱数生成器等の保存したいオブジェクトを最初に登録し、
+毎フレームCaptureで状態をリングバッファへ保存、Restoreで任意のフレームへ巻き戻す
+保存・復元は登録されたメモリ領域のmemcpyのみで行い、リングバッファは最初のCapture時に一度だけ確保する
+EncodeDeltaで２つのフレームの差分を圧縮した形式で取り出せるため、リプレイの記録や通信に使用できる
+
+リングバッファには各フレームの状態を差分にせずそのまま保存する(キーフレームと差分の形式にはしない)
+RestoreとEncodeDeltaがどのフレームでも１回のコピー・比較で済み、巻き戻す時に差分を順に適用する処理が発生しないため
+その代わり、使用するメモリは常に(保存しておくフレーム数 + 1) × GetStateSize()バイトとなる
+*/
+class BattleSnapshot {
+private:
+	struct Region {
+		unsigned char* Data;
+		size_t Size;
+	};
+	std::vector<Region> Regions;
+	size_t StateSize;
+	size_t Capacity;
+	std::vector<unsigned char> Ring;
+	std::vector<std::uint64_t> FrameList;
+	size_t Next;
+	size_t Count;
+	unsigned char* GetSlot(const size_t Index) noexcept { return this->Ring.data() + Index * this->StateSize; }
+	const unsigned char* GetSlot(const size_t Index) const noexcept { return this->Ring.data() + Index * this->StateSize; }
+	// 保存されているフレームの位置を探す。見つからない場合はCapacityを返す
+	size_t FindSlot(const std::uint64_t Frame) const noexcept {
+		for (size_t i = 0; i < this->Count; i++) {
+			const size_t Index = (this->Next + this->Capacity - 1 - i) % this->Capacity;
+			if (this->FrameList[Index] == Frame) return Index;
+		}
+		return this->Capacity;
+	}
+	void Scatter(const unsigned char* Src) noexcept {
+		for (const Region& r : this->Regions) {
+			std::memcpy(r.Data, Src, r.Size);
+			Src += r.Size;
+		}
+	}
+	static void WriteVarint(std::vector<unsigned char>& Out, size_t Num) {
+		while (Num >= 0x80) {
+			Out.push_back(static_cast<unsigned char>(Num | 0x80));
+			Num >>= 7;
+		}
+		Out.push_back(static_cast<unsigned char>(Num));
+	}
+	static bool ReadVarint(const std::vector<unsigned char>& In, size_t& Position, size_t& Num) noexcept {
+		Num = 0;
+		for (unsigned int Shift = 0; Position < In.size() && Shift < sizeof(size_t) * 8; Shift += 7) {
+			const unsigned char c = In[Position++];
+			Num |= static_cast<size_t>(c & 0x7F) << Shift;
+			if ((c & 0x80) == 0) return true;
+		}
+		return false;
+	}
+public:
+	// 引数：保存しておくフレーム数
+	BattleSnapshot(const size_t Capacity) : StateSize(0), Capacity(Capacity), Next(0), Count(0) {
+		if (Capacity == 0) throw std::runtime_error("capacity must be larger than 0.");
+	}
+	// メモリ領域を登録する。登録した領域はスナップショットを使い終わるまで移動・解放してはならない
+	// 例外：既にCaptureした後に登録した場合、std::runtime_errorが投げられる
+	void Register(void* Data, const size_t Size) {
+		if (!this->Ring.empty()) throw std::runtime_error("cannot register state after capture.");
+		this->Regions.push_back({ static_cast<unsigned char*>(Data), Size });
+		this->StateSize += Size;
+	}
+	// オブジェクトを登録する
+	// RegisterStateメンバ関数を持つクラスはそれを呼び出し、それ以外はトリビアルコピー可能である必要がある
+	template<class T>
+	void Register(T& Object) {
+		if constexpr (standard::internal::has_register_state<T>::value) Object.RegisterState(*this);
+		else {
+			static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable or have RegisterState.");
+			this->Register(static_cast<void*>(&Object), sizeof(T));
+		}
+	}
+	// 配列の要素を登録する。登録後に要素数を変更してはならない
+	template<class T>
+	void Register(std::vector<T>& List) {
+		static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable.");
+		if (!List.empty()) this->Register(static_cast<void*>(List.data()), sizeof(T) * List.size());
+	}
+	// １フレーム分の状態のサイズを取得する
+	size_t GetStateSize() const noexcept { return this->StateSize; }
+	// 現在の状態を保存する。保存しておけるフレーム数を超える場合、最も古いフレームが破棄される
+	void Capture(const std::uint64_t Frame) {
+		if (this->Ring.empty()) {
+			this->Ring.resize(this->StateSize * (this->Capacity + 1));
+			this->FrameList.resize(this->Capacity);
+		}
+		unsigned char* Dst = this->GetSlot(this->Next);
+		for (const Region& r : this->Regions) {
+			std::memcpy(Dst, r.Data, r.Size);
+			Dst += r.Size;
+		}
+		this->FrameList[this->Next] = Frame;
+		this->Next = (this->Next + 1) % this->Capacity;
+		if (this->Count < this->Capacity) this->Count++;
+	}
+	// 指定されたフレームが保存されているかを判定する
+	bool IsCaptured(const std::uint64_t Frame) const noexcept { return this->FindSlot(Frame) != this->Capacity; }
+	// 指定されたフレームの状態に戻す。そのフレームより後に保存されたフレームは破棄される
+	// 戻り値：フレームが保存されていない場合はfalse
+	bool Restore(const std::uint64_t Frame) noexcept {
+		const size_t Index = this->FindSlot(Frame);
+		if (Index == this->Capacity) return false;
+		this->Scatter(this->GetSlot(Index));
+		const size_t Discarded = (this->Next + this->Capacity - 1 - Index) % this->Capacity;
+		this->Count -= Discarded;
+		this->Next = (Index + 1) % this->Capacity;
+		return true;
+	}
+	// ２つのフレームの差分を出力する
+	// 形式は (変化していないバイト数, 変化したバイト数, 変化したバイトとBaseFrameのXOR) の繰り返し(数値は可変長整数)
+	// 第１引数：基準となるフレーム
+	// 第２引数：差分を取るフレーム
+	// 第３引数：出力先。容量は再利用される
+	// 例外　　：フレームが保存されていない場合、std::runtime_errorが投げられる
+	void EncodeDelta(const std::uint64_t BaseFrame, const std::uint64_t Frame, std::vector<unsigned char>& Out) const {
+		const size_t BaseIndex = this->FindSlot(BaseFrame), Index = this->FindSlot(Frame);
+		if (BaseIndex == this->Capacity || Index == this->Capacity) throw std::runtime_error("frame is not captured.");
+		const unsigned char* Base = this->GetSlot(BaseIndex);
+		const unsigned char* Current = this->GetSlot(Index);
+		Out.clear();
+		for (size_t i = 0; i < this->StateSize;) {
+			size_t Same = i;
+			while (Same < this->StateSize && Base[Same] == Current[Same]) Same++;
+			if (Same == this->StateSize) break;
+			size_t Diff = Same;
+			while (Diff < this->StateSize && Base[Diff] != Current[Diff]) Diff++;
+			WriteVarint(Out, Same - i);
+			WriteVarint(Out, Diff - Same);
+			for (size_t j = Same; j < Diff; j++) Out.push_back(static_cast<unsigned char>(Base[j] ^ Current[j]));
+			i = Diff;
+		}
+	}
+	// 保存されているフレームに差分を適用した状態に戻す。リングバッファの内容は変更されない
+	// 戻り値：基準となるフレームが保存されていない場合、差分の形式が正しくない場合はfalse
+	bool RestoreFromDelta(const std::uint64_t BaseFrame, const std::vector<unsigned char>& Delta) noexcept {
+		const size_t BaseIndex = this->FindSlot(BaseFrame);
+		if (BaseIndex == this->Capacity) return false;
+		// リングバッファの末尾の予備領域で復元する
+		unsigned char* Work = this->GetSlot(this->Capacity);
+		std::memcpy(Work, this->GetSlot(BaseIndex), this->StateSize);
+		size_t Position = 0, Offset = 0;
+		while (Position < Delta.size()) {
+			size_t Same, Diff;
+			if (!ReadVarint(Delta, Position, Same) || !ReadVarint(Delta, Position, Diff)) return false;
+			// 外部から受け取った差分でも加算が桁あふれしないよう、残りの大きさと個別に比較する
+			if (Same > this->StateSize - Offset) return false;
+			Offset += Same;
+			if (Diff > this->StateSize - Offset || Diff > Delta.size() - Position) return false;
+			for (size_t j = 0; j < Diff; j++) Work[Offset + j] ^= Delta[Position + j];
+			Offset += Diff;
+			Position += Diff;
+		}
+		this->Scatter(Work);
+		return true;
+	}
+};
+#endif
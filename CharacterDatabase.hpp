@@ -0,0 +1,291 @@
+﻿#ifndef __CHARACTERDATABASE_HPP__
+#define __CHARACTERDATABASE_HPP__
+#include "PossibleChangeStatus.hpp"
+#include "UseDamageCalculationParameter.hpp"
+#include "SpeedManager.hpp"
+#include "LevelManager.hpp"
+#include "SkillTable.hpp"
+#include "MemoryMappedFile.hpp"
+#include "FileWriter.hpp"
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <memory>
+#include <fstream>
+#include <filesystem>
+#include <unordered_map>
+#include <algorithm>
+#include <type_traits>
+
+// キャラクターデータベースに保存する１キャラクター分の固定長レコード(全て実行環境のバイトオーダー)
+struct CharacterRecord {
+	static constexpr std::uint32_t MaxSkillNum = 16;
+	static constexpr std::uint32_t DeletedFlag = 1;
+	struct StatusField {
+		std::int32_t Current, Max, Min;
+	};
+	struct ParameterField {
+		std::int32_t Default, Current, Max, Min;
+	};
+	std::uint64_t Id;					// キャラクターの識別子
+	std::uint32_t Flags;				// DeletedFlagが立っている場合は削除の記録
+	std::uint32_t SkillNum;				// 覚えているスキル数
+	std::uint64_t Exp;					// 経験値
+	std::uint32_t CurveId;				// 経験値の表の番号(利用側で定義する)
+	std::uint32_t Reserved;
+	StatusField HP, MP;
+	ParameterField Attack, Defence, Speed;
+	std::uint32_t Skill[MaxSkillNum];	// SkillTableのSkillId
+	// パラメーターからレコードを作成する
+	// 例外：スキル数がMaxSkillNumを超える場合、std::runtime_errorが投げられる
+	static CharacterRecord Create(const std::uint64_t Id, const PossibleChangeStatus<int>& HP, const PossibleChangeStatus<int>& MP,
+		const UseDamageCalculationParameter<int>& Attack, const UseDamageCalculationParameter<int>& Defence, const SpeedManager<int>& Speed,
+		const size_t Exp = 0, const std::uint32_t CurveId = 0, const std::vector<SkillId>& Skills = {}) {
+		if (Skills.size() > MaxSkillNum) throw std::runtime_error("too many skills for a character record.");
+		CharacterRecord Record{};
+		Record.Id = Id;
+		Record.SkillNum = static_cast<std::uint32_t>(Skills.size());
+		Record.Exp = Exp;
+		Record.CurveId = CurveId;
+		Record.HP = { HP.Get(), HP.GetMax(), HP.GetMin() };
+		Record.MP = { MP.Get(), MP.GetMax(), MP.GetMin() };
+		Record.Attack = { Attack.GetDefault(), Attack.Get(), Attack.GetMax(), Attack.GetMin() };
+		Record.Defence = { Defence.GetDefault(), Defence.Get(), Defence.GetMax(), Defence.GetMin() };
+		Record.Speed = { Speed.GetDefault(), Speed.Get(), Speed.GetMax(), Speed.GetMin() };
+		for (size_t i = 0; i < Skills.size(); i++) Record.Skill[i] = static_cast<std::uint32_t>(Skills[i]);
+		return Record;
+	}
+};
+static_assert(std::is_trivially_copyable<CharacterRecord>::value && sizeof(CharacterRecord) == 168, "CharacterRecord layout is part of the file format.");
+
+// マップされたレコードを参照するビュー。パラメーターは取得する時に初めて組み立てる
+class CharacterView {
+private:
+	const CharacterRecord* Record;
+	template<class Parameter>
+	static Parameter MakeParameter(const CharacterRecord::ParameterField& Field) {
+		Parameter Result(Field.Default, Field.Max, Field.Min);
+		if (Field.Current != Result.Get()) Result.ChangeCurrentNumToReserevedNum(Field.Current);
+		return Result;
+	}
+public:
+	CharacterView(const CharacterRecord* Record = nullptr) noexcept : Record(Record) {}
+	// レコードを参照しているかを判定する(見つからなかった場合はfalse)
+	explicit operator bool() const noexcept { return this->Record != nullptr; }
+	// レコードをそのまま取得する
+	const CharacterRecord& GetRecord() const noexcept { return *this->Record; }
+	std::uint64_t GetId() const noexcept { return this->Record->Id; }
+	PossibleChangeStatus<int> GetHP() const { return PossibleChangeStatus<int>(this->Record->HP.Current, this->Record->HP.Max, this->Record->HP.Min); }
+	PossibleChangeStatus<int> GetMP() const { return PossibleChangeStatus<int>(this->Record->MP.Current, this->Record->MP.Max, this->Record->MP.Min); }
+	UseDamageCalculationParameter<int> GetAttack() const { return MakeParameter<UseDamageCalculationParameter<int>>(this->Record->Attack); }
+	UseDamageCalculationParameter<int> GetDefence() const { return MakeParameter<UseDamageCalculationParameter<int>>(this->Record->Defence); }
+	SpeedManager<int> GetSpeed() const { return MakeParameter<SpeedManager<int>>(this->Record->Speed); }
+	size_t GetExp() const noexcept { return static_cast<size_t>(this->Record->Exp); }
+	std::uint32_t GetCurveId() const noexcept { return this->Record->CurveId; }
+	// 引数：CurveIdに対応する経験値の表
+	LevelManager GetLevelManager(const LevelCurve& Curve) const { return LevelManager(Curve, this->GetExp()); }
+	// 覚えているスキルを取得する
+	// 戻り値：レコードのstd::uint32_tの配列をSkillIdとして読む範囲
+	SkillIdRange GetSkills() const noexcept {
+		return SkillIdRange(this->Record->Skill, this->Record->Skill + std::min(this->Record->SkillNum, CharacterRecord::MaxSkillNum));
+	}
+};
+
+/*
+キャラクターデータベース
+ファイルをメモリにマップし、レコードを解析せずにそのまま参照する。起動時に全キャラクターを組み立てる必要はなく、読んだページのみが読み込まれる
+
+ファイルの構成(全て実行環境のバイトオーダー)
+Header
+CharacterRecord[RecordNum]
+　先頭のSortedNum個 : 識別子の昇順に並んだ重複のないレコード(二分探索で検索する)
+　それ以降　　　　　: 追記されたレコード。同じ識別子は後のものが優先され、DeletedFlagのレコードは削除を表す
+
+CharacterRecord[RecordNum]以降　: 追記用に確保した領域(内容は無視される)
+
+開く時は追記された部分のみを読んで識別子からレコード位置への索引を作る。Compactで追記部分を整列済みの部分にまとめる
+追記したレコードを記憶装置に反映(fsync/FlushFileBuffers)させてからヘッダーのRecordNumを更新するため、書き込み途中で終了した場合や電源が落ちた場合も、ヘッダーが指すのは書き込み済みのレコードのみとなる
+ヘッダーの更新は反映を待たないため、電源が落ちた場合は直前の追記が失われることがある
+追記用の領域はまとめて確保し、その範囲の追記はマップしたままファイルに書き込む。領域が足りなくなった時のみファイルを拡張してマップし直す
+
+領域を拡張する追記とCompactではファイルがマップし直されるため、Append、Remove、Compactの後はそれ以前に取得したCharacterViewを使用してはならない
+*/
+class CharacterDatabase {
+public:
+	static constexpr std::uint32_t FormatMagic = 0x42444843; // "CHDB"
+	static constexpr std::uint32_t FormatVersion = 1;
+private:
+	struct Header {
+		std::uint32_t Magic, Version, RecordSize, Reserved;
+		std::uint64_t RecordNum, SortedNum;
+	};
+	std::string FilePath;
+	std::unique_ptr<MemoryMappedFile> File;
+	std::unique_ptr<FileWriter> Writer;	// 追記用に開いたままにするファイル
+	const CharacterRecord* Records;
+	std::uint64_t RecordNum;
+	std::uint64_t SortedNum;
+	std::uint64_t Capacity;		// マップされている範囲に収まるレコード数
+	std::unordered_map<std::uint64_t, std::uint64_t> AppendedIndex;	// 追記された部分の識別子→レコード位置
+	size_t LiveNum;
+	// ファイルを作成して書き込み、記憶装置に反映させる
+	static void WriteFile(const std::string& FilePath, const Header& Head, const CharacterRecord* Records, const size_t Num) {
+		if (!std::ofstream(FilePath, std::ios::binary | std::ios::trunc)) throw std::runtime_error("failed to write " + FilePath);
+		FileWriter Writer(FilePath);
+		if (!Writer.Write(0, &Head, sizeof(Header)) || !Writer.Write(sizeof(Header), Records, sizeof(CharacterRecord) * Num) || !Writer.Sync())
+			throw std::runtime_error("failed to write " + FilePath);
+	}
+	// 追記用の領域を拡張する時に確保する最小のレコード数
+	static constexpr std::uint64_t MinGrowNum = 1024;
+	static constexpr std::uint64_t GetOffset(const std::uint64_t Index) noexcept { return sizeof(Header) + sizeof(CharacterRecord) * Index; }
+	const CharacterRecord* FindSorted(const std::uint64_t Id) const noexcept {
+		const CharacterRecord* End = this->Records + this->SortedNum;
+		const CharacterRecord* it = std::lower_bound(this->Records, End, Id, [](const CharacterRecord& r, const std::uint64_t Id) { return r.Id < Id; });
+		return it != End && it->Id == Id ? it : nullptr;
+	}
+	const CharacterRecord* FindRecord(const std::uint64_t Id) const noexcept {
+		const auto it = this->AppendedIndex.find(Id);
+		const CharacterRecord* Record = it != this->AppendedIndex.end() ? this->Records + it->second : this->FindSorted(Id);
+		return Record != nullptr && (Record->Flags & CharacterRecord::DeletedFlag) == 0 ? Record : nullptr;
+	}
+	void Map() {
+		this->File.reset();
+		this->File = std::make_unique<MemoryMappedFile>(this->FilePath);
+		if (this->File->GetSize() < sizeof(Header)) throw std::runtime_error("character database is too small.");
+		Header Head;
+		std::memcpy(&Head, this->File->GetData(), sizeof(Header));
+		if (Head.Magic != FormatMagic || Head.Version != FormatVersion) throw std::runtime_error("invalid character database format.");
+		if (Head.RecordSize != sizeof(CharacterRecord)) throw std::runtime_error("character database record size mismatch.");
+		// RecordNumはファイルの大きさから求めた上限と比較し、オフセットの計算が桁あふれしないようにする
+		const std::uint64_t Capacity = (this->File->GetSize() - sizeof(Header)) / sizeof(CharacterRecord);
+		if (Head.RecordNum > Capacity || Head.SortedNum > Head.RecordNum) throw std::runtime_error("character database is truncated.");
+		this->Records = reinterpret_cast<const CharacterRecord*>(static_cast<const unsigned char*>(this->File->GetData()) + sizeof(Header));
+		this->RecordNum = Head.RecordNum;
+		this->SortedNum = Head.SortedNum;
+		this->Capacity = Capacity;
+	}
+	// 追記された部分のレコードを索引に加える
+	void IndexAppended(const std::uint64_t Begin) {
+		for (std::uint64_t i = Begin; i < this->RecordNum; i++) {
+			const std::uint64_t Id = this->Records[i].Id;
+			const bool Existed = this->FindRecord(Id) != nullptr;
+			this->AppendedIndex[Id] = i;
+			const bool Exists = (this->Records[i].Flags & CharacterRecord::DeletedFlag) == 0;
+			if (Exists && !Existed) this->LiveNum++;
+			else if (!Exists && Existed) this->LiveNum--;
+		}
+	}
+	void Write(const CharacterRecord* Src, const size_t Num) {
+		if (Num == 0) return;
+		const std::uint64_t Begin = this->RecordNum;
+		const Header Head{ FormatMagic, FormatVersion, sizeof(CharacterRecord), 0, Begin + Num, this->SortedNum };
+		// 確保済みの領域に収まらない場合のみ拡張する。マップ中のファイルの大きさは変更できないため、先に解放する
+		const bool Grow = Num > this->Capacity - Begin;
+		bool Succeeded = true;
+		if (Grow) {
+			this->File.reset();
+			this->Records = nullptr;
+			Succeeded = this->Writer->Resize(GetOffset(Begin + std::max<std::uint64_t>(Num, std::max(MinGrowNum, Begin / 2))));
+		}
+		// 確保済みの領域への書き込みはマップした内容にもそのまま反映される
+		// レコードを記憶装置に反映させてからヘッダーを書き込み、ヘッダーが未反映のレコードを指さないようにする
+		Succeeded = Succeeded && this->Writer->Write(GetOffset(Begin), Src, sizeof(CharacterRecord) * Num) && this->Writer->Sync()
+			&& this->Writer->Write(0, &Head, sizeof(Header));
+		if (Grow) this->Map();
+		else if (Succeeded) this->RecordNum = Begin + Num;
+		if (!Succeeded) throw std::runtime_error("failed to write " + this->FilePath);
+		this->IndexAppended(Begin);
+	}
+public:
+	// 既存のデータベースを開く
+	// 例外：ファイルを開けない場合、形式が正しくない場合、std::runtime_errorが投げられる
+	CharacterDatabase(const std::string& FilePath) : FilePath(FilePath), Records(nullptr), RecordNum(0), SortedNum(0), Capacity(0), LiveNum(0) {
+		this->Map();
+		this->Writer = std::make_unique<FileWriter>(FilePath);
+		this->LiveNum = static_cast<size_t>(this->SortedNum);
+		this->IndexAppended(this->SortedNum);
+	}
+	CharacterDatabase(const CharacterDatabase&) = delete;
+	CharacterDatabase& operator = (const CharacterDatabase&) = delete;
+	// 空のデータベースを作成して開く。既にファイルがある場合は上書きする
+	// 例外：ファイルに書き込めない場合、std::runtime_errorが投げられる
+	static CharacterDatabase Create(const std::string& FilePath) {
+		WriteFile(FilePath, Header{ FormatMagic, FormatVersion, sizeof(CharacterRecord), 0, 0, 0 }, nullptr, 0);
+		return CharacterDatabase(FilePath);
+	}
+	CharacterDatabase(CharacterDatabase&&) = default;
+	// 登録されているキャラクター数を取得する
+	size_t Size() const noexcept { return this->LiveNum; }
+	// ファイル内のレコード数を取得する(上書き前・削除済みのレコードを含む)
+	size_t GetRecordNum() const noexcept { return static_cast<size_t>(this->RecordNum); }
+	// 追記されたレコード数を取得する。多くなった場合はCompactを呼び出す
+	size_t GetAppendedNum() const noexcept { return static_cast<size_t>(this->RecordNum - this->SortedNum); }
+	// キャラクターを検索する
+	// 戻り値：見つからない場合は何も参照しないビュー
+	CharacterView Find(const std::uint64_t Id) const noexcept { return CharacterView(this->FindRecord(Id)); }
+	bool Contains(const std::uint64_t Id) const noexcept { return this->FindRecord(Id) != nullptr; }
+	// レコードを追記する。同じ識別子のキャラクターは上書きされる
+	// 例外：ファイルに書き込めない場合、std::runtime_errorが投げられる
+	void Append(const CharacterRecord& Record) {
+		CharacterRecord Src = Record;
+		Src.Flags &= ~CharacterRecord::DeletedFlag;
+		this->Write(&Src, 1);
+	}
+	// 複数のレコードをまとめて追記する(ファイルの書き込みは１回のみ)
+	void Append(const std::vector<CharacterRecord>& Records) {
+		std::vector<CharacterRecord> Src(Records);
+		for (CharacterRecord& r : Src) r.Flags &= ~CharacterRecord::DeletedFlag;
+		this->Write(Src.data(), Src.size());
+	}
+	// キャラクターを削除する(削除の記録を追記する)
+	// 戻り値：見つからなかった場合はfalse
+	bool Remove(const std::uint64_t Id) {
+		if (!this->Contains(Id)) return false;
+		CharacterRecord Deleted{};
+		Deleted.Id = Id;
+		Deleted.Flags = CharacterRecord::DeletedFlag;
+		this->Write(&Deleted, 1);
+		return true;
+	}
+	// 登録されている全てのキャラクターに対してCallback(CharacterView)を呼び出す。順序は不定
+	template<class Function>
+	void ForEach(Function&& Callback) const {
+		for (std::uint64_t i = 0; i < this->SortedNum; i++) {
+			if (this->AppendedIndex.count(this->Records[i].Id) == 0) Callback(CharacterView(this->Records + i));
+		}
+		for (const auto& Entry : this->AppendedIndex) {
+			const CharacterRecord& Record = this->Records[Entry.second];
+			if ((Record.Flags & CharacterRecord::DeletedFlag) == 0) Callback(CharacterView(&Record));
+		}
+	}
+	// 追記された部分を整列済みの部分にまとめ、上書き前・削除済みのレコードを取り除く
+	// 一時ファイルに書き出してから置き換えるため、途中で失敗しても元のファイルは壊れない
+	// 例外：ファイルに書き込めない場合、std::runtime_errorが投げられる
+	void Compact() {
+		std::vector<CharacterRecord> Live;
+		Live.reserve(this->LiveNum);
+		this->ForEach([&Live](const CharacterView& View) { Live.push_back(View.GetRecord()); });
+		std::sort(Live.begin(), Live.end(), [](const CharacterRecord& a, const CharacterRecord& b) { return a.Id < b.Id; });
+		const std::string TemporaryPath = this->FilePath + ".compact";
+		WriteFile(TemporaryPath, Header{ FormatMagic, FormatVersion, sizeof(CharacterRecord), 0, Live.size(), Live.size() }, Live.data(), Live.size());
+		// Windowsでは開いているファイルを置き換えられないため、先に閉じる
+		this->File.reset();
+		this->Writer.reset();
+		this->Records = nullptr;
+		std::error_code Error;
+		std::filesystem::rename(TemporaryPath, this->FilePath, Error);
+		if (Error) {
+			// 一時ファイルが消せなくても元のファイルは無事なため、削除の失敗は無視する
+			std::error_code RemoveError;
+			std::filesystem::remove(TemporaryPath, RemoveError);
+		}
+		this->AppendedIndex.clear();
+		this->Map();
+		this->Writer = std::make_unique<FileWriter>(this->FilePath);
+		this->LiveNum = static_cast<size_t>(this->SortedNum);
+		this->IndexAppended(this->SortedNum);
+		if (Error) throw std::runtime_error("failed to replace " + this->FilePath);
+	}
+};
+#endif
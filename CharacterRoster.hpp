@@ -0,0 +1,172 @@
+﻿#ifndef __CHARACTERROSTER_HPP__
+#define __CHARACTERROSTER_HPP__
+#include "PossibleChangeStatus.hpp"
+#include "UseDamageCalculationParameter.hpp"
+#include "SpeedManager.hpp"
+#include <vector>
+#include <stdexcept>
+
+enum class RosterStatus : size_t { HP = 0, MP = 1, Attack = 2, Defence = 3, Speed = 4 };
+
+// 複数キャラクターのパラメーターをパラメーター毎の連続した配列で管理するクラス
+// 全体攻撃や全体回復等、多数のキャラクターに同じ処理を行う場合に使用する
+template<typename T, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
+class CharacterRoster {
+private:
+	struct StatusColumn {
+		std::vector<T> Current, Maximum, Minimum;
+		void PushBack(const standard::number<T>& Status) {
+			this->Current.push_back(Status.Get());
+			this->Maximum.push_back(Status.GetMax());
+			this->Minimum.push_back(Status.GetMin());
+		}
+	};
+	struct ParameterColumn : public StatusColumn {
+		std::vector<T> Default;
+	};
+	StatusColumn HP, MP;
+	ParameterColumn Attack, Defence, Speed;
+	StatusColumn& GetColumn(const RosterStatus Status) {
+		switch (Status) {
+			case RosterStatus::HP: return this->HP;
+			case RosterStatus::MP: return this->MP;
+			case RosterStatus::Attack: return this->Attack;
+			case RosterStatus::Defence: return this->Defence;
+			case RosterStatus::Speed: return this->Speed;
+			default: throw std::runtime_error("invalid roster status.");
+		}
+	}
+	const StatusColumn& GetColumn(const RosterStatus Status) const { return const_cast<CharacterRoster*>(this)->GetColumn(Status); }
+	ParameterColumn& GetParameterColumn(const RosterStatus Status) {
+		switch (Status) {
+			case RosterStatus::Attack: return this->Attack;
+			case RosterStatus::Defence: return this->Defence;
+			case RosterStatus::Speed: return this->Speed;
+			default: throw std::runtime_error("HP and MP have no default parameter.");
+		}
+	}
+	static constexpr Instrumentation::StatKind GetStatKind(const RosterStatus Status) noexcept {
+		return Status == RosterStatus::HP || Status == RosterStatus::MP ? Instrumentation::StatKind::Status
+			: Status == RosterStatus::Speed ? Instrumentation::StatKind::Speed : Instrumentation::StatKind::Parameter;
+	}
+	// 全キャラクターの現在値をCalc(キャラクターのインデックス, 現在値)の結果に変更し、最小値と最大値の範囲に収める
+	// STATUS_INSTRUMENTATIONが定義されていない場合、ループはそのままベクトル化される
+	template<class Function>
+	void Update(const RosterStatus Status, Function&& Calc) {
+		StatusColumn& Column = this->GetColumn(Status);
+		T* Current = Column.Current.data();
+		const T* Max = Column.Maximum.data();
+		const T* Min = Column.Minimum.data();
+#ifdef STATUS_INSTRUMENTATION
+		const Instrumentation::StatKind Kind = GetStatKind(Status);
+		for (size_t i = 0, Num = this->Size(); i < Num; i++) {
+			const T Requested = Calc(i, Current[i]);
+			const T After = standard::clamp<T>(Requested, Min[i], Max[i]);
+			STATUS_INSTRUMENT_MUTATION(Current + i, Kind, Current[i], After, Requested, Max[i], Min[i]);
+			Current[i] = After;
+		}
+#else
+		for (size_t i = 0, Num = this->Size(); i < Num; i++) Current[i] = standard::clamp<T>(Calc(i, Current[i]), Min[i], Max[i]);
+#endif
+	}
+public:
+	CharacterRoster() = default;
+	// 引数：予約するキャラクター数
+	CharacterRoster(const size_t ReserveNum) { this->Reserve(ReserveNum); }
+	void Reserve(const size_t ReserveNum) {
+		for (StatusColumn* Column : { &this->HP, &this->MP, static_cast<StatusColumn*>(&this->Attack), static_cast<StatusColumn*>(&this->Defence), static_cast<StatusColumn*>(&this->Speed) }) {
+			Column->Current.reserve(ReserveNum);
+			Column->Maximum.reserve(ReserveNum);
+			Column->Minimum.reserve(ReserveNum);
+		}
+		for (ParameterColumn* Column : { &this->Attack, &this->Defence, &this->Speed }) Column->Default.reserve(ReserveNum);
+	}
+	// キャラクターを追加する
+	// 戻り値：追加したキャラクターのインデックス
+	size_t Add(const PossibleChangeStatus<T>& HP, const PossibleChangeStatus<T>& MP,
+		const UseDamageCalculationParameter<T>& Attack, const UseDamageCalculationParameter<T>& Defence, const SpeedManager<T>& Speed) {
+		this->HP.PushBack(HP);
+		this->MP.PushBack(MP);
+		this->Attack.PushBack(Attack);
+		this->Attack.Default.push_back(Attack.GetDefault());
+		this->Defence.PushBack(Defence);
+		this->Defence.Default.push_back(Defence.GetDefault());
+		this->Speed.PushBack(Speed);
+		this->Speed.Default.push_back(Speed.GetDefault());
+		return this->HP.Current.size() - 1;
+	}
+	// 登録されているキャラクター数を取得する
+	size_t Size() const noexcept { return this->HP.Current.size(); }
+	// 現在値を取得する
+	T Get(const RosterStatus Status, const size_t Index) const { return this->GetColumn(Status).Current[Index]; }
+	// 最大値を取得する
+	T GetMax(const RosterStatus Status, const size_t Index) const { return this->GetColumn(Status).Maximum[Index]; }
+	// 最小値を取得する
+	T GetMin(const RosterStatus Status, const size_t Index) const { return this->GetColumn(Status).Minimum[Index]; }
+	// 現在値の先頭ポインタを取得する
+	const T* Data(const RosterStatus Status) const { return this->GetColumn(Status).Current.data(); }
+	// 指定されたキャラクターのパラメーターをPossibleChangeStatusとして取得する
+	PossibleChangeStatus<T> GetStatus(const RosterStatus Status, const size_t Index) const {
+		const StatusColumn& Column = this->GetColumn(Status);
+		return PossibleChangeStatus<T>(Column.Current[Index], Column.Maximum[Index], Column.Minimum[Index]);
+	}
+	// 全キャラクターのパラメーターから値を引く
+	// 第１引数：対象パラメーター
+	// 第２引数：キャラクター毎の減算値(キャラクター数分の要素が必要)
+	void Subtract(const RosterStatus Status, const T* Values) {
+		this->Update(Status, [Values](const size_t i, const T Current) { return standard::saturating_sub(Current, Values[i]); });
+	}
+	// 全キャラクターのパラメーターに値を足す
+	// 第１引数：対象パラメーター
+	// 第２引数：キャラクター毎の加算値(キャラクター数分の要素が必要)
+	void Add(const RosterStatus Status, const T* Values) {
+		this->Update(Status, [Values](const size_t i, const T Current) { return standard::saturating_add(Current, Values[i]); });
+	}
+	// 全キャラクターのパラメーターに同じ値を足す
+	void AddAll(const RosterStatus Status, const T Val) {
+		this->Update(Status, [Val](const size_t, const T Current) { return standard::saturating_add(Current, Val); });
+	}
+	// 全キャラクターのＨＰにダメージを与える
+	// 引数：キャラクター毎のダメージ(キャラクター数分の要素が必要)
+	void ApplyDamage(const T* Damage) { this->Subtract(RosterStatus::HP, Damage); }
+	// 全キャラクターのＨＰを最大値まで回復する
+	void HealAll() { this->HP.Current = this->HP.Maximum; }
+	// 全キャラクターの攻撃力、守備力、素早さを元に戻す
+	void Reset() {
+		for (ParameterColumn* Column : { &this->Attack, &this->Defence, &this->Speed }) Column->Current = Column->Default;
+	}
+	// 指定されたパラメーターのみ元に戻す
+	void Reset(const RosterStatus Status) {
+		ParameterColumn& Column = this->GetParameterColumn(Status);
+		Column.Current = Column.Default;
+	}
+	// BattleSnapshotに全キャラクターの現在値を登録する。登録後にキャラクターを追加してはならない
+	template<class Snapshot>
+	void RegisterState(Snapshot& State) {
+		for (StatusColumn* Column : { &this->HP, &this->MP, static_cast<StatusColumn*>(&this->Attack), static_cast<StatusColumn*>(&this->Defence), static_cast<StatusColumn*>(&this->Speed) })
+			State.Register(Column->Current);
+	}
+	// 全キャラクターについて、パラメーターが最小値であるかを判定する
+	// 第１引数：対象パラメーター
+	// 第２引数：判定結果の出力先(最小値であれば1、そうでなければ0)
+	void IsMin(const RosterStatus Status, std::vector<unsigned char>& Mask) const {
+		const StatusColumn& Column = this->GetColumn(Status);
+		const T* Current = Column.Current.data();
+		const T* Min = Column.Minimum.data();
+		const size_t Num = this->Size();
+		Mask.resize(Num);
+		unsigned char* Out = Mask.data();
+		for (size_t i = 0; i < Num; i++) Out[i] = static_cast<unsigned char>(Current[i] == Min[i]);
+	}
+	// 全キャラクターについて、パラメーターが最大値であるかを判定する
+	void IsMax(const RosterStatus Status, std::vector<unsigned char>& Mask) const {
+		const StatusColumn& Column = this->GetColumn(Status);
+		const T* Current = Column.Current.data();
+		const T* Max = Column.Maximum.data();
+		const size_t Num = this->Size();
+		Mask.resize(Num);
+		unsigned char* Out = Mask.data();
+		for (size_t i = 0; i < Num; i++) Out[i] = static_cast<unsigned char>(Current[i] == Max[i]);
+	}
+};
+#endif
@@ -0,0 +1,39 @@
+﻿#ifndef __COUNTERBASEDRANDOM_HPP__
+#define __COUNTERBASEDRANDOM_HPP__
+#include <cstdint>
+#include <type_traits>
+
+// カウンターベースの乱数生成器
+// 内部状態を持たず、シード・カウンター・ストリーム番号から値を算出するため、同じ引数からは常に同じ値が得られる
+// 戦闘の再現やスレッド毎に独立した乱数列が必要な場合に使用する
+class CounterBasedRandom {
+private:
+	std::uint64_t Seed;
+public:
+	// SplitMix64の出力関数
+	static constexpr std::uint64_t Mix(std::uint64_t x) noexcept {
+		x += 0x9E3779B97F4A7C15ull;
+		x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+		x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+		return x ^ (x >> 31);
+	}
+	constexpr CounterBasedRandom(const std::uint64_t Seed = 0) noexcept : Seed(Seed) {}
+	constexpr std::uint64_t GetSeed() const noexcept { return this->Seed; }
+	// 第１引数：カウンター(ターン数等)
+	// 第２引数：ストリーム番号(キャラクター番号等)
+	// 戻り値　：64bitの乱数
+	constexpr std::uint64_t operator () (const std::uint64_t Counter, const std::uint64_t Stream = 0) const noexcept {
+		return Mix(Mix(this->Seed ^ Mix(Counter)) + Stream);
+	}
+	// [Min, Max]の範囲の整数を生成する
+	template<typename T, std::enable_if_t<std::is_integral<T>::value, std::nullptr_t> = nullptr>
+	constexpr T Generate(const std::uint64_t Counter, const std::uint64_t Stream, const T Min, const T Max) const noexcept {
+		using U = std::make_unsigned_t<T>;
+		const std::uint64_t Range = static_cast<std::uint64_t>(static_cast<U>(static_cast<U>(Max) - static_cast<U>(Min))) + 1;
+		const std::uint64_t Rand = this->operator()(Counter, Stream);
+		// Rangeが2^32以下の場合は除算を使わずに範囲へ写像する
+		const std::uint64_t Offset = Range == 0 ? Rand : Range <= (1ull << 32) ? ((Rand >> 32) * Range) >> 32 : Rand % Range;
+		return static_cast<T>(static_cast<U>(static_cast<U>(Min) + static_cast<U>(Offset)));
+	}
+};
+#endif
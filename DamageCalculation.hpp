@@ -0,0 +1,170 @@
+﻿#ifndef __DAMAGECALCULATION_HPP__
+#define __DAMAGECALCULATION_HPP__
+#include "Element.hpp"
+#include <vector>
+#include <stdexcept>
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define DAMAGECALCULATION_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define DAMAGECALCULATION_TARGET_AVX2
+#else
+#define DAMAGECALCULATION_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+// ダメージ計算式
+// ダメージ = max(基本攻撃力 + 攻撃力 - 守備力 / 2, 0) * 属性によるダメージ倍率(小数点以下切り捨て)
+// 全ての計算はfloatで行い、SIMD版とスカラー版で同じ演算順序を取るため、どの実装を使用しても結果は完全に一致する
+namespace DamageCalculation {
+	enum class SimdLevel { Scalar = 0, SSE2 = 1, AVX2 = 2 };
+
+	// intに変換できるfloatの最大値
+	constexpr float MaxDamage = 2147483520.0f;
+
+	// 実行中のCPUで使用可能な最も高速な命令セットを取得する
+	inline SimdLevel GetSupportedSimdLevel() noexcept {
+#if defined(DAMAGECALCULATION_X86)
+#ifdef _MSC_VER
+		static const SimdLevel Level = [] {
+			int Info[4];
+			__cpuid(Info, 0);
+			if (Info[0] < 7) return SimdLevel::SSE2;
+			__cpuid(Info, 1);
+			const bool OSXSave = (Info[2] & (1 << 27)) != 0;
+			if (!OSXSave || (_xgetbv(0) & 6) != 6) return SimdLevel::SSE2;
+			__cpuidex(Info, 7, 0);
+			return (Info[1] & (1 << 5)) != 0 ? SimdLevel::AVX2 : SimdLevel::SSE2;
+		}();
+#else
+		static const SimdLevel Level = __builtin_cpu_supports("avx2") ? SimdLevel::AVX2 : SimdLevel::SSE2;
+#endif
+		return Level;
+#else
+		return SimdLevel::Scalar;
+#endif
+	}
+
+	// 第１引数：攻撃力
+	// 第２引数：技の基本攻撃力
+	// 第３引数：守備力
+	// 第４引数：属性によるダメージ倍率(0以上)
+	// 戻り値　：ダメージ
+	inline int CalcDamage(const int Attack, const int BasePower, const int Defence, const float Magnification) noexcept {
+		const float Base = (static_cast<float>(BasePower) + static_cast<float>(Attack)) - static_cast<float>(Defence) * 0.5f;
+		// SIMD版のmax/min命令と同じ比較にし、NaNは0、NaN・無限大の倍率による結果はMaxDamageになるようにする
+		const float Damage = (Base > 0.0f ? Base : 0.0f) * Magnification;
+		return static_cast<int>(Damage < MaxDamage ? Damage : MaxDamage);
+	}
+
+	namespace internal {
+		// 攻撃力・基本攻撃力は要素毎の配列(const int*)と全要素共通の値(int)のどちらでも受け取れるようにする
+		inline int At(const int* Value, const size_t i) noexcept { return Value[i]; }
+		inline int At(const int Value, const size_t) noexcept { return Value; }
+		inline const int* Advance(const int* Value, const size_t i) noexcept { return Value + i; }
+		inline int Advance(const int Value, const size_t) noexcept { return Value; }
+
+		template<class AttackType, class BasePowerType>
+		inline void CalcDamageScalar(const AttackType Attack, const BasePowerType BasePower, const int* Defence, const float* Magnification, int* Damage, const size_t Num) noexcept {
+			for (size_t i = 0; i < Num; i++) Damage[i] = CalcDamage(At(Attack, i), At(BasePower, i), Defence[i], Magnification[i]);
+		}
+#if defined(DAMAGECALCULATION_X86)
+		inline __m128 LoadSSE2(const int* Value, const size_t i) noexcept { return _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(Value + i))); }
+		inline __m128 LoadSSE2(const int Value, const size_t) noexcept { return _mm_set1_ps(static_cast<float>(Value)); }
+		DAMAGECALCULATION_TARGET_AVX2 inline __m256 LoadAVX2(const int* Value, const size_t i) noexcept { return _mm256_cvtepi32_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(Value + i))); }
+		DAMAGECALCULATION_TARGET_AVX2 inline __m256 LoadAVX2(const int Value, const size_t) noexcept { return _mm256_set1_ps(static_cast<float>(Value)); }
+
+		template<class AttackType, class BasePowerType>
+		inline void CalcDamageSSE2(const AttackType Attack, const BasePowerType BasePower, const int* Defence, const float* Magnification, int* Damage, const size_t Num) noexcept {
+			const __m128 Half = _mm_set1_ps(0.5f), Zero = _mm_setzero_ps(), Max = _mm_set1_ps(MaxDamage);
+			size_t i = 0;
+			for (; i + 4 <= Num; i += 4) {
+				const __m128 Atk = LoadSSE2(Attack, i);
+				const __m128 Pow = LoadSSE2(BasePower, i);
+				const __m128 Def = LoadSSE2(Defence, i);
+				const __m128 Base = _mm_sub_ps(_mm_add_ps(Pow, Atk), _mm_mul_ps(Def, Half));
+				const __m128 Dmg = _mm_min_ps(_mm_mul_ps(_mm_max_ps(Base, Zero), _mm_loadu_ps(Magnification + i)), Max);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(Damage + i), _mm_cvttps_epi32(Dmg));
+			}
+			CalcDamageScalar(Advance(Attack, i), Advance(BasePower, i), Defence + i, Magnification + i, Damage + i, Num - i);
+		}
+		template<class AttackType, class BasePowerType>
+		DAMAGECALCULATION_TARGET_AVX2 inline void CalcDamageAVX2(const AttackType Attack, const BasePowerType BasePower, const int* Defence, const float* Magnification, int* Damage, const size_t Num) noexcept {
+			const __m256 Half = _mm256_set1_ps(0.5f), Zero = _mm256_setzero_ps(), Max = _mm256_set1_ps(MaxDamage);
+			size_t i = 0;
+			for (; i + 8 <= Num; i += 8) {
+				const __m256 Atk = LoadAVX2(Attack, i);
+				const __m256 Pow = LoadAVX2(BasePower, i);
+				const __m256 Def = LoadAVX2(Defence, i);
+				const __m256 Base = _mm256_sub_ps(_mm256_add_ps(Pow, Atk), _mm256_mul_ps(Def, Half));
+				const __m256 Dmg = _mm256_min_ps(_mm256_mul_ps(_mm256_max_ps(Base, Zero), _mm256_loadu_ps(Magnification + i)), Max);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(Damage + i), _mm256_cvttps_epi32(Dmg));
+			}
+			CalcDamageScalar(Advance(Attack, i), Advance(BasePower, i), Defence + i, Magnification + i, Damage + i, Num - i);
+		}
+#endif
+		template<class AttackType, class BasePowerType>
+		inline void CalcDamage(const AttackType Attack, const BasePowerType BasePower, const int* Defence, const float* Magnification, int* Damage, const size_t Num,
+			const SimdLevel Level) noexcept {
+			switch (Level) {
+#if defined(DAMAGECALCULATION_X86)
+				case SimdLevel::AVX2:
+					CalcDamageAVX2(Attack, BasePower, Defence, Magnification, Damage, Num);
+					break;
+				case SimdLevel::SSE2:
+					CalcDamageSSE2(Attack, BasePower, Defence, Magnification, Damage, Num);
+					break;
+#endif
+				default:
+					CalcDamageScalar(Attack, BasePower, Defence, Magnification, Damage, Num);
+					break;
+			}
+		}
+	}
+
+	// 要素毎にダメージを計算する
+	// 第１～４引数：攻撃力、技の基本攻撃力、守備力、属性によるダメージ倍率の配列(それぞれ第６引数の数の要素が必要)
+	// 第５引数　　：ダメージの出力先
+	// 第７引数　　：使用する命令セット。CPUが対応していない命令セットを指定してはならない
+	inline void CalcDamage(const int* Attack, const int* BasePower, const int* Defence, const float* Magnification, int* Damage, const size_t Num,
+		const SimdLevel Level = GetSupportedSimdLevel()) noexcept {
+		internal::CalcDamage(Attack, BasePower, Defence, Magnification, Damage, Num, Level);
+	}
+
+	// １人の攻撃側が１つの技で複数の防御側を攻撃する場合のダメージを計算する
+	// 攻撃力と基本攻撃力は全要素で共通のため、配列に展開せずにSIMDレジスタの全要素へ複製して計算する
+	// 第１、２引数：攻撃力、技の基本攻撃力
+	// 第３、４引数：守備力、属性によるダメージ倍率の配列(それぞれ第６引数の数の要素が必要)
+	// 第５引数　　：ダメージの出力先
+	// 第７引数　　：使用する命令セット。CPUが対応していない命令セットを指定してはならない
+	inline void CalcDamage(const int Attack, const int BasePower, const int* Defence, const float* Magnification, int* Damage, const size_t Num,
+		const SimdLevel Level = GetSupportedSimdLevel()) noexcept {
+		internal::CalcDamage(Attack, BasePower, Defence, Magnification, Damage, Num, Level);
+	}
+
+	// 攻撃側×技×防御側の全ての組み合わせについてダメージを計算する
+	// 第１引数：攻撃側の攻撃力の配列
+	// 第２引数：技の配列(SkillA、SkillW)
+	// 第３引数：防御側の守備力の配列
+	// 第４引数：防御側の属性の配列(第３引数と同じ数の要素が必要)
+	// 第５引数：ダメージの出力先。Damage[(攻撃側 * 技の数 + 技) * 防御側の数 + 防御側]の順に格納される
+	// 第６引数：強みである属性による攻撃の場合のダメージ倍率
+	// 第７引数：弱点である属性による攻撃の場合のダメージ倍率
+	template<class SkillType>
+	inline void CalcDamage(const std::vector<int>& Attack, const std::vector<SkillType>& Skills, const std::vector<int>& Defence,
+		const std::vector<ElementInfo>& DefenceElement, std::vector<int>& Damage, const float DmgMgnfctByBtAttack, const float DmgMgnfctByWkAttack,
+		const SimdLevel Level = GetSupportedSimdLevel()) {
+		if (Defence.size() != DefenceElement.size()) throw std::runtime_error("defence and element count mismatch.");
+		const size_t TargetNum = Defence.size();
+		Damage.resize(Attack.size() * Skills.size() * TargetNum);
+		std::vector<float> Magnification(TargetNum);
+		for (size_t s = 0; s < Skills.size(); s++) {
+			for (size_t t = 0; t < TargetNum; t++)
+				Magnification[t] = ElementAdvantageTable.GetAdvantage(DefenceElement[t], Skills[s].SkillElement, DmgMgnfctByBtAttack, DmgMgnfctByWkAttack);
+			for (size_t a = 0; a < Attack.size(); a++)
+				CalcDamage(Attack[a], Skills[s].BasePower, Defence.data(), Magnification.data(), Damage.data() + (a * Skills.size() + s) * TargetNum, TargetNum, Level);
+		}
+	}
+}
+#endif
@@ -1,84 +1,187 @@
 ﻿#ifndef __ELEMENT_HPP__
 #define __ELEMENT_HPP__
+#include "Text.hpp"
 #include <string>
+#include <string_view>
 #include <vector>
-#include <algorithm>
+#include <array>
+#include <initializer_list>
 #include <stdexcept>
 
 enum class ElementInfo : size_t { Normal = 0, Fire = 1, Ice = 2, Thunder = 3, Earth = 4, Wind = 5, Shine = 6, Dark = 7 };
 
+enum class AdvantageType : unsigned char { Normal = 0, Weak = 1, Beauty = 2 };
+
+// 属性相性表。防御側属性×攻撃側属性の行列で相性とダメージ倍率を保持するため、判定時にメモリ確保も線形探索も行わない
+// 倍率は組み合わせ毎に保持し、SetMultiplierで特定の組み合わせだけ弱点・強みの倍率と異なる値にできる
+// テンプレート引数：登録可能な属性の数(ElementInfoの値はこの数未満である必要がある)
+template<size_t MaxElementNum = 16>
+class AdvantageTable {
+private:
+	std::array<AdvantageType, MaxElementNum * MaxElementNum> Table;
+	std::array<float, MaxElementNum * MaxElementNum> Multiplier;
+	float DmgMgnfctByBtAttack;
+	float DmgMgnfctByWkAttack;
+	static constexpr size_t ToIndex(const ElementInfo DefenceElement, const ElementInfo AttackElement) noexcept {
+		return static_cast<size_t>(DefenceElement) * MaxElementNum + static_cast<size_t>(AttackElement);
+	}
+	constexpr float ToMultiplier(const AdvantageType Type) const noexcept {
+		return Type == AdvantageType::Weak ? this->DmgMgnfctByWkAttack : Type == AdvantageType::Beauty ? this->DmgMgnfctByBtAttack : 1.0f;
+	}
+	constexpr void Set(const size_t Index, const AdvantageType Type) noexcept {
+		this->Table[Index] = Type;
+		this->Multiplier[Index] = this->ToMultiplier(Type);
+	}
+public:
+	// 指定された属性がこの相性表で扱えるかを判定する
+	static constexpr bool IsRegistrable(const ElementInfo Element) noexcept { return static_cast<size_t>(Element) < MaxElementNum; }
+	constexpr AdvantageTable() : Table(), Multiplier(), DmgMgnfctByBtAttack(0.5f), DmgMgnfctByWkAttack(2.0f) {
+		for (size_t i = 0; i < MaxElementNum * MaxElementNum; i++) this->Multiplier[i] = 1.0f;
+		this->Register(ElementInfo::Fire, { ElementInfo::Ice, ElementInfo::Earth }, { ElementInfo::Fire, ElementInfo::Thunder, ElementInfo::Wind });
+		this->Register(ElementInfo::Ice, { ElementInfo::Thunder, ElementInfo::Wind }, { ElementInfo::Fire, ElementInfo::Ice, ElementInfo::Earth });
+		this->Register(ElementInfo::Thunder, { ElementInfo::Fire, ElementInfo::Earth }, { ElementInfo::Ice, ElementInfo::Thunder, ElementInfo::Wind });
+		this->Register(ElementInfo::Earth, { ElementInfo::Ice, ElementInfo::Wind }, { ElementInfo::Fire, ElementInfo::Thunder, ElementInfo::Earth });
+		this->Register(ElementInfo::Wind, { ElementInfo::Fire, ElementInfo::Thunder }, { ElementInfo::Ice, ElementInfo::Earth, ElementInfo::Wind });
+		this->Register(ElementInfo::Shine, { ElementInfo::Dark }, { ElementInfo::Shine });
+		this->Register(ElementInfo::Dark, { ElementInfo::Shine }, { ElementInfo::Dark });
+	}
+	// 属性の相性を登録する。既に登録されている相性は上書きされる
+	// 第１引数：防御側の属性
+	// 第２引数：弱点である攻撃属性のリスト
+	// 第３引数：強みである攻撃属性のリスト
+	// 例外　　：登録可能な数を超える属性が指定された場合、std::runtime_errorが投げられる
+	constexpr void Register(const ElementInfo Element, const std::initializer_list<ElementInfo> Weak, const std::initializer_list<ElementInfo> Beauty) {
+		if (!IsRegistrable(Element)) throw std::runtime_error("element is out of range of advantage table.");
+		for (size_t i = 0; i < MaxElementNum; i++) this->Set(ToIndex(Element, static_cast<ElementInfo>(i)), AdvantageType::Normal);
+		for (const ElementInfo Elem : Weak) this->SetAdvantageType(Element, Elem, AdvantageType::Weak);
+		for (const ElementInfo Elem : Beauty) this->SetAdvantageType(Element, Elem, AdvantageType::Beauty);
+	}
+	// 属性の組み合わせ１つ分の相性を変更する。倍率は相性に応じた値に戻される
+	// 例外：登録可能な数を超える属性が指定された場合、std::runtime_errorが投げられる
+	constexpr void SetAdvantageType(const ElementInfo DefenceElement, const ElementInfo AttackElement, const AdvantageType Type) {
+		if (!IsRegistrable(DefenceElement) || !IsRegistrable(AttackElement)) throw std::runtime_error("element is out of range of advantage table.");
+		this->Set(ToIndex(DefenceElement, AttackElement), Type);
+	}
+	// 属性の組み合わせ１つ分のダメージ倍率を変更する(相性は変更しない)
+	// 例外：登録可能な数を超える属性が指定された場合、std::runtime_errorが投げられる
+	constexpr void SetMultiplier(const ElementInfo DefenceElement, const ElementInfo AttackElement, const float Multiplier) {
+		if (!IsRegistrable(DefenceElement) || !IsRegistrable(AttackElement)) throw std::runtime_error("element is out of range of advantage table.");
+		this->Multiplier[ToIndex(DefenceElement, AttackElement)] = Multiplier;
+	}
+	// 倍率を指定しない場合に使用するダメージ倍率を変更する。SetMultiplierで個別に変更した倍率も含め、全ての組み合わせの倍率を相性に応じた値に設定し直す
+	// 第１引数：強みである属性による攻撃の場合のダメージ倍率
+	// 第２引数：弱点である属性による攻撃の場合のダメージ倍率
+	constexpr void SetMagnification(const float DmgMgnfctByBtAttack, const float DmgMgnfctByWkAttack) noexcept {
+		this->DmgMgnfctByBtAttack = DmgMgnfctByBtAttack;
+		this->DmgMgnfctByWkAttack = DmgMgnfctByWkAttack;
+		for (size_t i = 0; i < MaxElementNum * MaxElementNum; i++) this->Multiplier[i] = this->ToMultiplier(this->Table[i]);
+	}
+	// 相性を取得する。登録されていない属性の場合はAdvantageType::Normalを返す
+	constexpr AdvantageType GetAdvantageType(const ElementInfo DefenceElement, const ElementInfo AttackElement) const noexcept {
+		return IsRegistrable(DefenceElement) && IsRegistrable(AttackElement) ? this->Table[ToIndex(DefenceElement, AttackElement)] : AdvantageType::Normal;
+	}
+	// 第１引数：防御側の属性
+	// 第２引数：攻撃属性
+	// 第３引数：強みである属性による攻撃の場合のダメージ倍率
+	// 第４引数：弱点である属性による攻撃の場合のダメージ倍率
+	// 戻り値　：ダメージ倍率
+	constexpr float GetAdvantage(const ElementInfo DefenceElement, const ElementInfo AttackElement, const float DmgMgnfctByBtAttack, const float DmgMgnfctByWkAttack) const noexcept {
+		const float Magnification[] = { 1.0f, DmgMgnfctByWkAttack, DmgMgnfctByBtAttack };
+		return Magnification[static_cast<size_t>(this->GetAdvantageType(DefenceElement, AttackElement))];
+	}
+	// 第１引数：防御側の属性
+	// 第２引数：攻撃属性
+	// 戻り値　：組み合わせ毎のダメージ倍率(SetMagnification、SetMultiplierで設定されたもの)。登録されていない属性の場合は1
+	constexpr float GetAdvantage(const ElementInfo DefenceElement, const ElementInfo AttackElement) const noexcept {
+		return IsRegistrable(DefenceElement) && IsRegistrable(AttackElement) ? this->Multiplier[ToIndex(DefenceElement, AttackElement)] : 1.0f;
+	}
+};
+
+// Element、AdvantageInfo、DamageCalculation、BattleSimulatorが参照する属性相性表
+// 同期を行わずに読み取るため、属性の追加や相性・倍率の変更は起動時(他のスレッドが参照を始める前)に済ませること
+// 戦闘中に相性を変える場合は、別のAdvantageTableを作成してElement::Advantageの引数に渡す
+inline AdvantageTable<> ElementAdvantageTable{};
+
 class AdvantageInfo {
 private:
-	std::vector<ElementInfo> WeakElement;
-	std::vector<ElementInfo> BeautyElement;
-	AdvantageInfo(const std::vector<ElementInfo> Weak, const std::vector<ElementInfo> Beauty) : WeakElement(Weak), BeautyElement(Beauty) {}
+	ElementInfo Elem;
 public:
-	AdvantageInfo(const ElementInfo Element) {
-		switch (Element) {
-			case ElementInfo::Fire:
-				AdvantageInfo({ ElementInfo::Ice, ElementInfo::Earth }, { ElementInfo::Fire, ElementInfo::Thunder, ElementInfo::Wind });
-				break;
-			case ElementInfo::Ice:
-				AdvantageInfo({ ElementInfo::Thunder, ElementInfo::Wind }, { ElementInfo::Fire, ElementInfo::Ice, ElementInfo::Earth });
-				break;
-			case ElementInfo::Thunder:
-				AdvantageInfo({ ElementInfo::Fire, ElementInfo::Earth }, { ElementInfo::Ice, ElementInfo::Thunder, ElementInfo::Wind });
-				break;
-			case ElementInfo::Earth:
-				AdvantageInfo({ ElementInfo::Ice, ElementInfo::Wind }, { ElementInfo::Fire, ElementInfo::Thunder, ElementInfo::Earth });
-				break;
-			case ElementInfo::Wind:
-				AdvantageInfo({ ElementInfo::Fire, ElementInfo::Thunder }, { ElementInfo::Ice, ElementInfo::Earth, ElementInfo::Wind });
-				break;
-			case ElementInfo::Shine:
-				AdvantageInfo({ ElementInfo::Dark }, { ElementInfo::Shine });
-				break;
-			case ElementInfo::Dark:
-				AdvantageInfo({ ElementInfo::Shine }, { ElementInfo::Dark });
-				break;
-			default:
-				throw std::runtime_error("入力された属性はこのクラスでは相性判定できません。");
-		 }
+	AdvantageInfo(const ElementInfo Element) : Elem(Element) {
+		if (Element == ElementInfo::Normal || !AdvantageTable<>::IsRegistrable(Element))
+			throw std::runtime_error("入力された属性はこのクラスでは相性判定できません。");
 	}
 	// 第１引数：攻撃属性
 	// 第２引数：強みである属性による攻撃の場合のダメージ倍率
 	// 第３引数：弱点である属性による攻撃の場合のダメージ倍率
 	// 戻り値　：ダメージ倍率
-	float GetAdvantage(const ElementInfo AttackElement, const float DmgMgnfctByBtAttack, const float DmgMgnfctByWkAttack) const {
-		return this->IsWeakElement(AttackElement) ? 2.0f : (this->IsBeautyElement(AttackElement) ? 0.5f : 1.0f);
+	float GetAdvantage(const ElementInfo AttackElement, const float DmgMgnfctByBtAttack, const float DmgMgnfctByWkAttack) const noexcept {
+		return ElementAdvantageTable.GetAdvantage(this->Elem, AttackElement, DmgMgnfctByBtAttack, DmgMgnfctByWkAttack);
 	}
 	// 引数：攻撃属性
-	bool IsWeakElement(const ElementInfo AttackElement) const {
-		return std::any_of(this->WeakElement.begin(), this->WeakElement.end(), [AttackElement](const ElementInfo Elem) { return AttackElement == Elem; });
+	bool IsWeakElement(const ElementInfo AttackElement) const noexcept {
+		return ElementAdvantageTable.GetAdvantageType(this->Elem, AttackElement) == AdvantageType::Weak;
 	}
 	// 引数：攻撃属性
-	bool IsBeautyElement(const ElementInfo AttackElement) const {
-		return std::any_of(this->BeautyElement.begin(), this->BeautyElement.end(), [AttackElement](const ElementInfo Elem) { return AttackElement == Elem; });
+	bool IsBeautyElement(const ElementInfo AttackElement) const noexcept {
+		return ElementAdvantageTable.GetAdvantageType(this->Elem, AttackElement) == AdvantageType::Beauty;
 	}
 };
 
+// 属性名から属性を取得する。属性名の先頭の文字が全て異なることを利用した完全ハッシュで検索するため、メモリの確保も線形探索も行わない
+// 受け付けるのは組み込みの８属性の小文字の名前のみ。AdvantageTableに追加した属性(ElementInfoの8以降の値)には名前がないため、
+// それらを読み込む場合は呼び出し側で名前から値への対応を持つこと
+// 組み込みの属性を増やす場合は、先頭の文字が既存の名前と重ならないようにし、ElementListとFirstCharacterTableを共に更新すること
+// 第１引数：属性名(normal、fire、ice、thunder、earth、wind、shine、dark)
+// 第２引数：属性の出力先。見つからない場合は変更されない
+// 戻り値　：属性名が見つかった場合はtrue
+template<typename CharT>
+constexpr bool TryParseElement(const std::basic_string_view<CharT> Name, ElementInfo& Result) noexcept {
+	constexpr std::string_view ElementList[] = { "normal", "fire", "ice", "thunder", "earth", "wind", "shine", "dark" };
+	// 'a'～'z'の先頭文字から属性への対応表(-1は該当なし)
+	constexpr signed char FirstCharacterTable[26] = {
+		-1, -1, -1, 7, 4, 1, -1, -1, 2, -1, -1, -1, -1, 0, -1, -1, -1, -1, 6, 3, -1, -1, 5, -1, -1, -1
+	};
+	if (Name.empty() || Name[0] < CharT('a') || Name[0] > CharT('z')) return false;
+	const signed char Index = FirstCharacterTable[Name[0] - CharT('a')];
+	if (Index < 0 || ElementList[Index].size() != Name.size()) return false;
+	for (size_t i = 1; i < Name.size(); i++) if (Name[i] != static_cast<CharT>(ElementList[Index][i])) return false;
+	Result = static_cast<ElementInfo>(Index);
+	return true;
+}
+
 class Element {
 private:
-	ElementInfo ElementCast(const std::string Element) noexcept {
-		// ユーザーが属性を自由に追加できるようにstd::vectorクラスにしてあるだけ
-		static const std::vector<std::string> ElementList = { "normal", "ice", "thunder", "earth", "wind", "shine", "dark" };
-		for (size_t i = 0; i < ElementList.size(); i++) if (Element == ElementList[i]) return static_cast<ElementInfo>(i);
-		return ElementInfo::Normal;
-	}
-	ElementInfo ElementCast(const std::wstring Element) noexcept {
-		static const std::vector<std::wstring> ElementList = { L"normal", L"ice", L"thunder", L"earth", L"wind", L"shine", L"dark" };
-		for (size_t i = 0; i < ElementList.size(); i++) if (Element == ElementList[i]) return static_cast<ElementInfo>(i);
-		return ElementInfo::Normal;
+	template<typename CharT>
+	static constexpr ElementInfo ElementCast(const std::basic_string_view<CharT> Element) noexcept {
+		ElementInfo Result = ElementInfo::Normal;
+		TryParseElement(Element, Result);
+		return Result;
 	}
 public:
 	Element() : Element(ElementInfo::Normal) {}
 	Element(const ElementInfo Elem) : Elem(Elem) {}
-	Element(const std::string Elem) : Element(this->ElementCast(Elem)) {}
-	Element(const std::wstring Elem) : Element(this->ElementCast(Elem)) {}
+	// 引数：属性名(std::string、std::wstring_view、文字列リテラル等、文字型は問わない)
+	template<class Text, class CharT = standard::text_char_t<Text>>
+	Element(const Text& Elem) : Element(ElementCast(standard::to_string_view(Elem))) {}
 	ElementInfo Elem;
-	float Advantage(const ElementInfo AttackElement, connst float DmgMgnfctByBtAttack, const float DmgMgnfctByWkAttack) const {
-		return (this->Elem == ElementInfo::Normal || AttackElement == ElementInfo::Normal)
-			? 1.0f : AdvantageInfo(this->Elem).GetAdvantage(AttackElement, DmgMgnfctByBtAttack, DmgMgnfctByWkAttack);
+	// 第１引数：攻撃属性
+	// 第２引数：強みである属性による攻撃の場合のダメージ倍率
+	// 第３引数：弱点である属性による攻撃の場合のダメージ倍率
+	// 戻り値　：ダメージ倍率
+	float Advantage(const ElementInfo AttackElement, const float DmgMgnfctByBtAttack, const float DmgMgnfctByWkAttack) const noexcept {
+		return ElementAdvantageTable.GetAdvantage(this->Elem, AttackElement, DmgMgnfctByBtAttack, DmgMgnfctByWkAttack);
+	}
+	// 引数　：攻撃属性
+	// 戻り値：属性相性表に設定されたダメージ倍率
+	float Advantage(const ElementInfo AttackElement) const noexcept {
+		return ElementAdvantageTable.GetAdvantage(this->Elem, AttackElement);
+	}
+	// 第１引数：攻撃属性
+	// 第２引数：使用する属性相性表(ElementAdvantageTableの代わりに使用する)
+	// 戻り値　：属性相性表に設定されたダメージ倍率
+	template<size_t MaxElementNum>
+	float Advantage(const ElementInfo AttackElement, const AdvantageTable<MaxElementNum>& Table) const noexcept {
+		return Table.GetAdvantage(this->Elem, AttackElement);
 	}
 };
 #endif
@@ -0,0 +1,89 @@
+﻿#ifndef __FILEWRITER_HPP__
+#define __FILEWRITER_HPP__
+#include <string>
+#include <cstdint>
+#include <stdexcept>
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <sys/types.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// 既存のファイルを開いたまま、位置を指定して書き込むクラス
+// 書き込んだ内容はSyncを呼ぶまでOSのキャッシュにのみあり、電源断等では失われる可能性がある
+class FileWriter {
+private:
+#ifdef _WIN32
+	HANDLE File;
+#else
+	int FileDescriptor;
+#endif
+public:
+	// 例外：ファイルを開けない場合、std::runtime_errorが投げられる
+	FileWriter(const std::string& FilePath) {
+#ifdef _WIN32
+		// MemoryMappedFileがマップしたまま書き込めるよう、読み書きの共有を許可する
+		this->File = CreateFileA(FilePath.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (this->File == INVALID_HANDLE_VALUE) throw std::runtime_error("failed to open " + FilePath);
+#else
+		this->FileDescriptor = open(FilePath.c_str(), O_RDWR);
+		if (this->FileDescriptor < 0) throw std::runtime_error("failed to open " + FilePath);
+#endif
+	}
+	FileWriter(const FileWriter&) = delete;
+	FileWriter& operator = (const FileWriter&) = delete;
+	~FileWriter() {
+#ifdef _WIN32
+		CloseHandle(this->File);
+#else
+		close(this->FileDescriptor);
+#endif
+	}
+	// 指定した位置から書き込む
+	// 戻り値：全て書き込めた場合はtrue
+	bool Write(const std::uint64_t Offset, const void* Data, const size_t Size) noexcept {
+		const char* Src = static_cast<const char*>(Data);
+		size_t Written = 0;
+		while (Written < Size) {
+#ifdef _WIN32
+			OVERLAPPED Position{};
+			Position.Offset = static_cast<DWORD>(Offset + Written);
+			Position.OffsetHigh = static_cast<DWORD>((Offset + Written) >> 32);
+			const size_t Rest = Size - Written;
+			DWORD Num = 0;
+			if (!WriteFile(this->File, Src + Written, static_cast<DWORD>(Rest < 0x40000000 ? Rest : 0x40000000), &Num, &Position) || Num == 0) return false;
+#else
+			const ssize_t Num = pwrite(this->FileDescriptor, Src + Written, Size - Written, static_cast<off_t>(Offset + Written));
+			if (Num <= 0) return false;
+#endif
+			Written += static_cast<size_t>(Num);
+		}
+		return true;
+	}
+	// ファイルの大きさを変更する。マップ中のファイルは変更できない環境があるため、先にマップを解放すること
+	// 戻り値：変更できた場合はtrue
+	bool Resize(const std::uint64_t Size) noexcept {
+#ifdef _WIN32
+		LARGE_INTEGER Position;
+		Position.QuadPart = static_cast<LONGLONG>(Size);
+		return SetFilePointerEx(this->File, Position, nullptr, FILE_BEGIN) && SetEndOfFile(this->File);
+#else
+		return ftruncate(this->FileDescriptor, static_cast<off_t>(Size)) == 0;
+#endif
+	}
+	// 書き込んだ内容を記憶装置に反映させる
+	// 戻り値：反映できた場合はtrue
+	bool Sync() noexcept {
+#ifdef _WIN32
+		return FlushFileBuffers(this->File) != 0;
+#else
+		return fsync(this->FileDescriptor) == 0;
+#endif
+	}
+};
+#endif
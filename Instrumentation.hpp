@@ -0,0 +1,254 @@
+﻿#ifndef __INSTRUMENTATION_HPP__
+#define __INSTRUMENTATION_HPP__
+#include <cstddef>
+#include <cstdint>
+
+/*
+パラメーターの変更を計測する機能
+STATUS_INSTRUMENTATIONを定義してビルドした場合のみ有効になり、定義しない場合は計測用のコードも記録用のメンバ変数も生成されない
+STATUS_INSTRUMENTATIONはプログラム全体で統一すること(翻訳単位毎に異なるとnumberの定義が一致しなくなる)
+
+有効な場合、number及びその派生クラス、CharacterRoster、AtomicPossibleChangeStatus、LevelManagerの変更時に
+・パラメーターの種類毎の変更回数
+・最大値・最小値に丸められた回数
+・レベルアップの回数
+を数え、変更内容をスレッド毎のロックを使用しないリングバッファに記録する
+記録はSetEnabledで実行中に停止・再開でき、DrainまたはTraceFileで任意のスレッドから取り出せる
+*/
+namespace Instrumentation {
+	// パラメーターの種類
+	enum class StatKind : unsigned char {
+		Number = 0,			// standard::number
+		Status = 1,			// PossibleChangeStatus(ＨＰ、ＭＰ等)
+		Parameter = 2,		// UseDamageCalculationParameter(攻撃力、守備力等)
+		Speed = 3,			// SpeedManager
+		Experience = 4,		// LevelManagerの経験値
+		Level = 5,			// LevelManagerのレベル
+		AtomicStatus = 6	// AtomicPossibleChangeStatus
+	};
+	constexpr size_t StatKindNum = 7;
+}
+
+#ifdef STATUS_INSTRUMENTATION
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <chrono>
+#include <string>
+#include <fstream>
+#include <stdexcept>
+
+#ifndef STATUS_INSTRUMENTATION_RING_SIZE
+// スレッド毎のリングバッファに保持するイベント数(2の累乗)
+#define STATUS_INSTRUMENTATION_RING_SIZE 4096
+#endif
+
+namespace Instrumentation {
+	// Setは最大値・最小値による丸めを行わずに値を直接設定した変更
+	enum class EventType : unsigned char { Mutation = 0, ClampMax = 1, ClampMin = 2, LevelUp = 3, Set = 4 };
+
+	// 記録されるイベント
+	struct Event {
+		std::uint64_t Time;			// steady_clockの経過時間(ナノ秒)
+		const void* Object;			// 変更されたパラメーターのアドレス
+		double Before;				// 変更前の値
+		double After;				// 変更後の値
+		double Requested;			// 最大値・最小値に丸める前の値
+		std::uint32_t Thread;		// 記録したスレッドの番号(登録順)
+		StatKind Kind;
+		EventType Type;
+	};
+
+	// 全スレッドの合計
+	struct Counter {
+		std::uint64_t Mutation[StatKindNum];	// 変更回数
+		std::uint64_t ClampMax[StatKindNum];	// 最大値に丸められた回数
+		std::uint64_t ClampMin[StatKindNum];	// 最小値に丸められた回数
+		std::uint64_t LevelUp;					// 上がったレベルの合計
+		std::uint64_t Dropped;					// リングバッファが一杯で記録できなかったイベント数
+	};
+
+	// 以下はスレッド毎の記録の管理。レジストリはプログラム全体で１つにするため、無名名前空間には置かない
+	namespace Internal {
+		// 書き込みは所有するスレッドのみが行うため、不可分な読み書きのみで加算する(ロック命令を使用しない)
+		inline void Increment(std::atomic<std::uint64_t>& Value, const std::uint64_t Num = 1) noexcept {
+			Value.store(Value.load(std::memory_order_relaxed) + Num, std::memory_order_relaxed);
+		}
+		// スレッド毎の記録。書き込みは所有するスレッドのみ、取り出しはDrain側のみが行う(単一生産者・単一消費者)
+		class ThreadLog {
+		private:
+			static constexpr size_t Capacity = STATUS_INSTRUMENTATION_RING_SIZE;
+			static_assert((Capacity & (Capacity - 1)) == 0, "STATUS_INSTRUMENTATION_RING_SIZE must be a power of 2.");
+			std::unique_ptr<Event[]> Ring;
+			alignas(64) std::atomic<std::uint64_t> Head;
+			alignas(64) std::atomic<std::uint64_t> Tail;
+		public:
+			const std::uint32_t Id;
+			std::atomic<std::uint64_t> Mutation[StatKindNum], ClampMax[StatKindNum], ClampMin[StatKindNum], LevelUp, Dropped;
+			ThreadLog(const std::uint32_t Id) : Ring(new Event[Capacity]), Head(0), Tail(0), Id(Id), Mutation(), ClampMax(), ClampMin(), LevelUp(0), Dropped(0) {}
+			void Push(const Event& e) noexcept {
+				const std::uint64_t h = this->Head.load(std::memory_order_relaxed);
+				if (h - this->Tail.load(std::memory_order_acquire) == Capacity) {
+					Increment(this->Dropped);
+					return;
+				}
+				this->Ring[h & (Capacity - 1)] = e;
+				this->Head.store(h + 1, std::memory_order_release);
+			}
+			template<class Function>
+			size_t Drain(Function&& Output) {
+				const std::uint64_t t = this->Tail.load(std::memory_order_relaxed);
+				const std::uint64_t h = this->Head.load(std::memory_order_acquire);
+				for (std::uint64_t i = t; i < h; i++) Output(this->Ring[i & (Capacity - 1)]);
+				this->Tail.store(h, std::memory_order_release);
+				return static_cast<size_t>(h - t);
+			}
+		};
+		struct Registry {
+			std::mutex Mutex;
+			std::vector<std::shared_ptr<ThreadLog>> Logs;
+			std::uint32_t NextId = 0;
+			std::atomic<bool> Enabled{ true };
+			Counter Retired{};	// 終了したスレッドの回数
+		};
+		inline void AddCounter(Counter& Result, const ThreadLog& Log) noexcept {
+			for (size_t i = 0; i < StatKindNum; i++) {
+				Result.Mutation[i] += Log.Mutation[i].load(std::memory_order_relaxed);
+				Result.ClampMax[i] += Log.ClampMax[i].load(std::memory_order_relaxed);
+				Result.ClampMin[i] += Log.ClampMin[i].load(std::memory_order_relaxed);
+			}
+			Result.LevelUp += Log.LevelUp.load(std::memory_order_relaxed);
+			Result.Dropped += Log.Dropped.load(std::memory_order_relaxed);
+		}
+		inline Registry& GetRegistry() {
+			static Registry Instance;
+			return Instance;
+		}
+		// 呼び出したスレッドの記録を取得する。初回のみ登録のためにロックを使用する
+		inline ThreadLog& GetThreadLog() {
+			thread_local const std::shared_ptr<ThreadLog> Log = [] {
+				Registry& r = GetRegistry();
+				std::lock_guard<std::mutex> Lock(r.Mutex);
+				r.Logs.push_back(std::make_shared<ThreadLog>(r.NextId++));
+				return r.Logs.back();
+			}();
+			return *Log;
+		}
+		inline std::uint64_t GetTime() noexcept {
+			return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+		}
+	}
+
+	// 記録を再開・停止する(既定では記録する)
+	inline void SetEnabled(const bool Enabled) noexcept { Internal::GetRegistry().Enabled.store(Enabled, std::memory_order_relaxed); }
+	inline bool IsEnabled() noexcept { return Internal::GetRegistry().Enabled.load(std::memory_order_relaxed); }
+
+	// パラメーターの変更を記録する
+	// 第１引数：パラメーターのアドレス
+	// 第２引数：パラメーターの種類
+	// 第３～５引数：変更前の値、変更後の値、最大値・最小値に丸める前の値
+	// 第６、７引数：最大値、最小値
+	template<typename T>
+	void RecordMutation(const void* Object, const StatKind Kind, const T Before, const T After, const T Requested, const T Max, const T Min) noexcept {
+		if (!IsEnabled()) return;
+		Internal::ThreadLog& Log = Internal::GetThreadLog();
+		const size_t Index = static_cast<size_t>(Kind);
+		const EventType Type = Requested > Max ? EventType::ClampMax : Requested < Min ? EventType::ClampMin : EventType::Mutation;
+		Internal::Increment(Log.Mutation[Index]);
+		if (Type == EventType::ClampMax) Internal::Increment(Log.ClampMax[Index]);
+		else if (Type == EventType::ClampMin) Internal::Increment(Log.ClampMin[Index]);
+		Log.Push(Event{ Internal::GetTime(), Object, static_cast<double>(Before), static_cast<double>(After), static_cast<double>(Requested), Log.Id, Kind, Type });
+	}
+	// 丸めを行わずに値を直接設定した変更を記録する(変更回数にのみ数える)
+	// 第１引数：パラメーターのアドレス
+	// 第２引数：パラメーターの種類
+	// 第３、４引数：変更前の値、変更後の値
+	template<typename T>
+	void RecordSet(const void* Object, const StatKind Kind, const T Before, const T After) noexcept {
+		if (!IsEnabled()) return;
+		Internal::ThreadLog& Log = Internal::GetThreadLog();
+		Internal::Increment(Log.Mutation[static_cast<size_t>(Kind)]);
+		Log.Push(Event{ Internal::GetTime(), Object, static_cast<double>(Before), static_cast<double>(After), static_cast<double>(After), Log.Id, Kind, EventType::Set });
+	}
+	// レベルアップを記録する
+	inline void RecordLevelUp(const void* Object, const unsigned int Before, const unsigned int After) noexcept {
+		if (!IsEnabled() || After <= Before) return;
+		Internal::ThreadLog& Log = Internal::GetThreadLog();
+		Internal::Increment(Log.LevelUp, After - Before);
+		Log.Push(Event{ Internal::GetTime(), Object, static_cast<double>(Before), static_cast<double>(After), static_cast<double>(After), Log.Id, StatKind::Level, EventType::LevelUp });
+	}
+
+	// 全スレッドの回数の合計を取得する(終了したスレッドの分も含む)
+	inline Counter GetCounter() {
+		Internal::Registry& r = Internal::GetRegistry();
+		std::lock_guard<std::mutex> Lock(r.Mutex);
+		Counter Result = r.Retired;
+		for (const std::shared_ptr<Internal::ThreadLog>& Log : r.Logs) Internal::AddCounter(Result, *Log);
+		return Result;
+	}
+
+	// 全スレッドのリングバッファからイベントを取り出す。イベントはスレッド毎に記録順で並ぶ
+	// 終了したスレッドのリングバッファは取り出した後に解放する
+	// 引数　：イベントの追加先
+	// 戻り値：取り出したイベント数
+	inline size_t Drain(std::vector<Event>& Events) {
+		Internal::Registry& r = Internal::GetRegistry();
+		std::lock_guard<std::mutex> Lock(r.Mutex);
+		size_t Num = 0;
+		for (size_t i = 0; i < r.Logs.size();) {
+			// 取り出す前に終了を確認し、確認後に記録されたイベントを取りこぼさないようにする
+			const bool Exited = r.Logs[i].use_count() == 1;
+			Num += r.Logs[i]->Drain([&Events](const Event& e) { Events.push_back(e); });
+			if (Exited) {
+				Internal::AddCounter(r.Retired, *r.Logs[i]);
+				r.Logs.erase(r.Logs.begin() + static_cast<std::ptrdiff_t>(i));
+			}
+			else i++;
+		}
+		return Num;
+	}
+
+	// イベントをCSV形式で書き出すファイル
+	class TraceFile {
+	private:
+		std::ofstream Stream;
+		std::vector<Event> Buffer;
+		static const char* ToString(const StatKind Kind) noexcept {
+			constexpr const char* Name[] = { "number", "status", "parameter", "speed", "experience", "level", "atomic_status" };
+			return Name[static_cast<size_t>(Kind)];
+		}
+		static const char* ToString(const EventType Type) noexcept {
+			constexpr const char* Name[] = { "mutation", "clamp_max", "clamp_min", "level_up", "set" };
+			return Name[static_cast<size_t>(Type)];
+		}
+	public:
+		// 例外：ファイルを開けない場合、std::runtime_errorが投げられる
+		TraceFile(const std::string& FilePath) : Stream(FilePath, std::ios::trunc) {
+			if (!this->Stream) throw std::runtime_error("failed to open " + FilePath);
+			this->Stream << "time_ns,thread,kind,event,object,before,after,requested\n";
+		}
+		// 全スレッドのリングバッファから取り出したイベントを書き出す
+		// 戻り値：書き出したイベント数
+		size_t Flush() {
+			this->Buffer.clear();
+			const size_t Num = Drain(this->Buffer);
+			for (const Event& e : this->Buffer) {
+				this->Stream << e.Time << ',' << e.Thread << ',' << ToString(e.Kind) << ',' << ToString(e.Type) << ','
+					<< e.Object << ',' << e.Before << ',' << e.After << ',' << e.Requested << '\n';
+			}
+			this->Stream.flush();
+			return Num;
+		}
+	};
+}
+
+#define STATUS_INSTRUMENT_MUTATION(Object, Kind, Before, After, Requested, Max, Min) ::Instrumentation::RecordMutation((Object), (Kind), (Before), (After), (Requested), (Max), (Min))
+#define STATUS_INSTRUMENT_SET(Object, Kind, Before, After) ::Instrumentation::RecordSet((Object), (Kind), (Before), (After))
+#define STATUS_INSTRUMENT_LEVELUP(Object, Before, After) ::Instrumentation::RecordLevelUp((Object), (Before), (After))
+#else
+#define STATUS_INSTRUMENT_MUTATION(Object, Kind, Before, After, Requested, Max, Min) ((void)0)
+#define STATUS_INSTRUMENT_SET(Object, Kind, Before, After) ((void)0)
+#define STATUS_INSTRUMENT_LEVELUP(Object, Before, After) ((void)0)
+#endif
+#endif
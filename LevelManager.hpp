@@ -2,39 +2,96 @@
 #define __LEVELMANAGER_HPP__
 #include "PossibleChangeStatus.hpp"
 #include <vector>
+#include <memory>
+#include <algorithm>
+
+// レベルアップに必要な経験値の表。コピーしても表そのものは共有されるため、職業毎に１つ作成して各キャラクターに渡す
+class LevelCurve {
+private:
+	std::shared_ptr<const std::vector<size_t>> LevelUpBorderPointList;
+public:
+	LevelCurve() = default;
+	// 引数 : レベル２に上がるのに必要な経験値から始まる、各レベルに上がるために必要な合計経験値のリスト
+	// 例外 : リストが空の場合、昇順に並んでいない場合、std::runtime_errorが投げられる
+	LevelCurve(std::vector<size_t> LevelUpBorderPointList) {
+		if (LevelUpBorderPointList.empty()) throw std::runtime_error("level up border point list is empty.");
+		if (!std::is_sorted(LevelUpBorderPointList.begin(), LevelUpBorderPointList.end())) throw std::runtime_error("level up border point list must be sorted.");
+		this->LevelUpBorderPointList = std::make_shared<const std::vector<size_t>>(std::move(LevelUpBorderPointList));
+	}
+	// 最大レベルを取得する
+	unsigned int GetMaxLevel() const noexcept { return static_cast<unsigned int>(this->LevelUpBorderPointList->size() + 1); }
+	// 経験値の上限を取得する
+	size_t GetMaxExp() const noexcept { return this->LevelUpBorderPointList->back(); }
+	// 指定されたレベルに上がるために必要な合計経験値を取得する(Levelは2以上、最大レベル以下)
+	size_t GetBorderPoint(const unsigned int Level) const noexcept { return (*this->LevelUpBorderPointList)[Level - 2]; }
+	// 経験値に対応するレベルを二分探索で取得する
+	unsigned int GetLevel(const size_t Exp) const noexcept {
+		return static_cast<unsigned int>(std::upper_bound(this->LevelUpBorderPointList->begin(), this->LevelUpBorderPointList->end(), Exp) - this->LevelUpBorderPointList->begin()) + 1;
+	}
+};
 
 class LevelManager {
 private:
-	std::vector<size_t> LevelUpBorderPointList;
+	LevelCurve Curve;
 	PossibleChangeStatus<size_t> Exp;
 	PossibleChangeStatus<unsigned int> Level;
 public:
-	LevelManager() = default;
+	LevelManager() {
+		this->Exp.SetStatKind(Instrumentation::StatKind::Experience);
+		this->Level.SetStatKind(Instrumentation::StatKind::Level);
+	}
+	/*
+	第１引数 : 職業等で共有するレベルアップに必要な経験値の表
+	第２引数 : 現在の経験値
+	*/
+	LevelManager(const LevelCurve& Curve, const size_t CurrentExp = 0)
+		: Curve(Curve), Exp({ CurrentExp, Curve.GetMaxExp() }),
+		Level({ Curve.GetLevel(std::min(CurrentExp, Curve.GetMaxExp())), Curve.GetMaxLevel(), 1 }) {
+		this->Exp.SetStatKind(Instrumentation::StatKind::Experience);
+		this->Level.SetStatKind(Instrumentation::StatKind::Level);
+	}
 	/*
 	第１引数 : レベル２に上がるのに必要な経験値から始まる、各レベルに上がるために必要な合計経験値のリスト
 	第２引数 : 現在の経験値
 	*/
 	LevelManager(const std::vector<size_t> LevelUpBorderPointList, const size_t CurrentExp = 0)
-		: LevelUpBorderPointList(LevelUpBorderPointList), Exp({ CurrentExp, LevelUpBorderPointList.back() }),
-		Level({ 1, static_cast<unsigned int>(LevelUpBorderPointList.size() + 1), 1 }) {
-		for (auto& i : this->LevelUpBorderPointList) {
-			if (this->Exp < i) break;
-			this->Level++;
-		}
-	}
+		: LevelManager(LevelCurve(LevelUpBorderPointList), CurrentExp) {}
 	// 現在の経験値を取得する
-	const size_t GetCurrentExp() const { return *this->Exp; }
+	size_t GetCurrentExp() const { return *this->Exp; }
 	// 現在のレベルを取得する
-	const unsigned int GetCurrentLevel() const { return *this->Level; }
-	// 次のレベルに上がるために必要な経験値を取得する
-	const size_t GetExpPointNeededToRaiseNextLevel() const { return this->LevelUpBorderPointList[*this->Level - 2] - *this->Exp; }
-	// 経験値を加算する。
+	unsigned int GetCurrentLevel() const { return *this->Level; }
+	// 参照している経験値の表を取得する
+	const LevelCurve& GetLevelCurve() const noexcept { return this->Curve; }
+	// 次のレベルに上がるために必要な経験値を取得する。最大レベルの場合は0を返す
+	size_t GetExpPointNeededToRaiseNextLevel() const {
+		return this->Level.IsMax() ? 0 : this->Curve.GetBorderPoint(*this->Level + 1) - *this->Exp;
+	}
+	// 経験値を加算する。一度に複数のレベルが上がる場合もある
 	// 戻り値 : 上がったレベル
 	unsigned int AddExp(const size_t AddExpPoint) {
 		this->Exp += AddExpPoint;
-		const PossibleChangeStatus<unsigned int> Before = this->Level;
-		if (this->Exp >= this->LevelUpBorderPointList[*this->Level - 2]) this->Level++;
-		return *this->Level - *Before;
+		if (this->Level.IsMax() || *this->Exp < this->Curve.GetBorderPoint(*this->Level + 1)) return 0;
+		const unsigned int Before = *this->Level;
+		this->Level.ChangeCurrentNumToReserevedNum(this->Curve.GetLevel(*this->Exp));
+		STATUS_INSTRUMENT_LEVELUP(this, Before, *this->Level);
+		return *this->Level - Before;
+	}
+	// BattleSnapshotに経験値とレベルを登録する
+	template<class Snapshot>
+	void RegisterState(Snapshot& State) {
+		State.Register(this->Exp);
+		State.Register(this->Level);
+	}
+	// パーティー全員に同じ経験値を加算する
+	// 第１引数 : パーティーメンバーのリスト
+	// 第２引数 : 加算する経験値
+	// 第３引数 : 各メンバーの上がったレベルの出力先(不要な場合はnullptr)
+	static void DistributeExp(std::vector<LevelManager>& Party, const size_t AddExpPoint, std::vector<unsigned int>* RaisedLevel = nullptr) {
+		if (RaisedLevel != nullptr) RaisedLevel->resize(Party.size());
+		for (size_t i = 0; i < Party.size(); i++) {
+			const unsigned int Raised = Party[i].AddExp(AddExpPoint);
+			if (RaisedLevel != nullptr) (*RaisedLevel)[i] = Raised;
+		}
 	}
 };
 #endif
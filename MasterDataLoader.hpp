@@ -0,0 +1,99 @@
+﻿#ifndef __MASTERDATALOADER_HPP__
+#define __MASTERDATALOADER_HPP__
+#include "Skill.hpp"
+#include "CharacterRoster.hpp"
+#include <string_view>
+#include <vector>
+#include <system_error>
+#include <type_traits>
+
+// CSV/TSV形式のテキストを１行ずつ読むクラス
+// 各フィールドは元のテキストを参照するstd::basic_string_viewとして返すため、フィールド毎のメモリ確保を行わない
+// 空行及び'#'で始まる行は読み飛ばす。引用符によるエスケープには対応しないため、区切り文字を含む文字列はTSVを使用すること
+template<typename CharT>
+class BasicDelimitedTextReader {
+public:
+	using StringView = std::basic_string_view<CharT>;
+private:
+	StringView Text;
+	size_t Position;
+	size_t LineNumber;
+	CharT Delimiter;
+public:
+	// 第１引数：読み込むテキスト(メモリにマップしたファイル等)。読み込みが終わるまで有効である必要がある
+	// 第２引数：区切り文字
+	BasicDelimitedTextReader(const StringView Text, const CharT Delimiter = CharT(',')) : Text(Text), Position(0), LineNumber(0), Delimiter(Delimiter) {}
+	// 最後に読んだ行の行番号(1から始まる)を取得する
+	size_t GetLineNumber() const noexcept { return this->LineNumber; }
+	// 次の行を読む
+	// 引数　：フィールドの出力先。容量は再利用されるため、同じvectorを使い続ければメモリの確保は最初の数行のみとなる
+	// 戻り値：行を読めた場合はtrue、テキストの終端に達した場合はfalse
+	bool ReadLine(std::vector<StringView>& Fields) {
+		while (this->Position < this->Text.size()) {
+			size_t End = this->Text.find(CharT('\n'), this->Position);
+			if (End == StringView::npos) End = this->Text.size();
+			StringView Line = this->Text.substr(this->Position, End - this->Position);
+			this->Position = End + 1;
+			this->LineNumber++;
+			if (!Line.empty() && Line.back() == CharT('\r')) Line.remove_suffix(1);
+			if (Line.empty() || Line.front() == CharT('#')) continue;
+			Fields.clear();
+			for (size_t Begin = 0;;) {
+				const size_t Next = Line.find(this->Delimiter, Begin);
+				Fields.push_back(Line.substr(Begin, Next == StringView::npos ? StringView::npos : Next - Begin));
+				if (Next == StringView::npos) break;
+				Begin = Next + 1;
+			}
+			return true;
+		}
+		return false;
+	}
+};
+
+typedef BasicDelimitedTextReader<char> DelimitedTextReaderA;
+typedef BasicDelimitedTextReader<wchar_t> DelimitedTextReaderW;
+
+namespace MasterDataLoader {
+	// スキルを読み込む
+	// 各行は 名前,消費MP,基本攻撃力,説明,属性名 の順(属性名はTryParseElementが受け付けるもの)
+	// BasicSkillViewに読み込む場合、名前と説明は読み込み元のテキストを参照するため行毎のメモリ確保は発生しない
+	// そのままSkillTableを作成すれば、文字列は表の文字列領域に一度だけコピーされる。BasicSkillに読み込む場合は行毎にコピーされる
+	// UTF-8のファイルをUTF-16等で扱う場合は、読み込む前にstandard::transcodeでテキスト全体を一度に変換する
+	// 第１引数：読み込み元
+	// 第２引数：読み込んだスキルの追加先(BasicSkillViewまたはBasicSkillの配列)
+	// 戻り値　：成功した場合はstd::errc()。失敗した場合は読み込み元のGetLineNumberでエラーのある行を取得できる
+	template<typename CharT, class Skill, std::enable_if_t<std::is_same<Skill, BasicSkill<CharT>>::value || std::is_same<Skill, BasicSkillView<CharT>>::value, std::nullptr_t> = nullptr>
+	std::errc LoadSkills(BasicDelimitedTextReader<CharT>& Reader, std::vector<Skill>& Skills) {
+		std::vector<std::basic_string_view<CharT>> Fields;
+		while (Reader.ReadLine(Fields)) {
+			if (Fields.size() != 5) return std::errc::invalid_argument;
+			Skill Result{};
+			if (const std::errc ec = standard::parse(Fields[1], Result.UseMP); ec != std::errc()) return ec;
+			if (const std::errc ec = standard::parse(Fields[2], Result.BasePower); ec != std::errc()) return ec;
+			if (!TryParseElement(Fields[4], Result.SkillElement)) return std::errc::invalid_argument;
+			Result.Name = Fields[0];
+			Result.Description = Fields[3];
+			Skills.push_back(std::move(Result));
+		}
+		return std::errc();
+	}
+	// キャラクターを読み込む
+	// 各行は 最大ＨＰ,最大ＭＰ,攻撃力,守備力,素早さ の順。ＨＰ、ＭＰは最大値で、各パラメーターの最小値は0で登録される
+	// 第１引数：読み込み元
+	// 第２引数：読み込んだキャラクターの追加先
+	// 戻り値　：成功した場合はstd::errc()。失敗した場合は読み込み元のGetLineNumberでエラーのある行を取得できる
+	template<typename CharT, typename T>
+	std::errc LoadCharacters(BasicDelimitedTextReader<CharT>& Reader, CharacterRoster<T>& Roster) {
+		std::vector<std::basic_string_view<CharT>> Fields;
+		while (Reader.ReadLine(Fields)) {
+			if (Fields.size() != 5) return std::errc::invalid_argument;
+			T Value[5];
+			for (size_t i = 0; i < 5; i++) if (const std::errc ec = standard::parse(Fields[i], Value[i]); ec != std::errc()) return ec;
+			const T Max = std::numeric_limits<T>::max();
+			Roster.Add(PossibleChangeStatus<T>(Value[0]), PossibleChangeStatus<T>(Value[1]),
+				UseDamageCalculationParameter<T>(Value[2], Max, 0), UseDamageCalculationParameter<T>(Value[3], Max, 0), SpeedManager<T>(Value[4], Max, 0));
+		}
+		return std::errc();
+	}
+}
+#endif
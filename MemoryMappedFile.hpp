@@ -0,0 +1,84 @@
+﻿#ifndef __MEMORYMAPPEDFILE_HPP__
+#define __MEMORYMAPPEDFILE_HPP__
+#include <string>
+#include <stdexcept>
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// ファイルを読み取り専用でメモリにマップするクラス。ページは実際に読まれた時に読み込まれる
+class MemoryMappedFile {
+private:
+	const void* Data;
+	size_t Size;
+#ifdef _WIN32
+	HANDLE File;
+	HANDLE Mapping;
+#endif
+public:
+	// 例外：ファイルを開けない場合、マップできない場合、std::runtime_errorが投げられる
+	MemoryMappedFile(const std::string& FilePath) : Data(nullptr), Size(0) {
+#ifdef _WIN32
+		// 追記型のファイル(CharacterDatabase等)がマップしたまま書き込めるよう、書き込みの共有を許可する
+		this->File = CreateFileA(FilePath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (this->File == INVALID_HANDLE_VALUE) throw std::runtime_error("failed to open " + FilePath);
+		LARGE_INTEGER FileSize;
+		if (!GetFileSizeEx(this->File, &FileSize)) {
+			CloseHandle(this->File);
+			throw std::runtime_error("failed to get size of " + FilePath);
+		}
+		this->Size = static_cast<size_t>(FileSize.QuadPart);
+		this->Mapping = nullptr;
+		if (this->Size == 0) return;
+		this->Mapping = CreateFileMappingA(this->File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (this->Mapping != nullptr) this->Data = MapViewOfFile(this->Mapping, FILE_MAP_READ, 0, 0, 0);
+		if (this->Data == nullptr) {
+			if (this->Mapping != nullptr) CloseHandle(this->Mapping);
+			CloseHandle(this->File);
+			throw std::runtime_error("failed to map " + FilePath);
+		}
+#else
+		const int FileDescriptor = open(FilePath.c_str(), O_RDONLY);
+		if (FileDescriptor < 0) throw std::runtime_error("failed to open " + FilePath);
+		struct stat FileStatus;
+		if (fstat(FileDescriptor, &FileStatus) != 0) {
+			close(FileDescriptor);
+			throw std::runtime_error("failed to get size of " + FilePath);
+		}
+		this->Size = static_cast<size_t>(FileStatus.st_size);
+		if (this->Size != 0) {
+			void* Mapped = mmap(nullptr, this->Size, PROT_READ, MAP_SHARED, FileDescriptor, 0);
+			if (Mapped == MAP_FAILED) {
+				close(FileDescriptor);
+				throw std::runtime_error("failed to map " + FilePath);
+			}
+			this->Data = Mapped;
+		}
+		close(FileDescriptor);
+#endif
+	}
+	MemoryMappedFile(const MemoryMappedFile&) = delete;
+	MemoryMappedFile& operator = (const MemoryMappedFile&) = delete;
+	~MemoryMappedFile() {
+#ifdef _WIN32
+		if (this->Data != nullptr) UnmapViewOfFile(this->Data);
+		if (this->Mapping != nullptr) CloseHandle(this->Mapping);
+		CloseHandle(this->File);
+#else
+		if (this->Data != nullptr) munmap(const_cast<void*>(this->Data), this->Size);
+#endif
+	}
+	// マップされた領域の先頭を取得する。空のファイルの場合はnullptr
+	const void* GetData() const noexcept { return this->Data; }
+	// マップされた領域のサイズを取得する
+	size_t GetSize() const noexcept { return this->Size; }
+};
+#endif
@@ -0,0 +1,135 @@
+﻿#ifndef __MODIFIERSTACK_HPP__
+#define __MODIFIERSTACK_HPP__
+#include "UseDamageCalculationParameter.hpp"
+#include "TimerWheel.hpp"
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+enum class ModifierType : unsigned char { Additive, Multiplicative };
+enum class ModifierId : std::uint32_t { Invalid = 0xFFFFFFFF };
+
+template<typename T, class Bounds> class ModifierStack;
+
+// TimerWheelに登録する効果切れの情報
+template<typename T, class Bounds = standard::dynamic_bounds<T>>
+struct ModifierExpiry {
+	ModifierStack<T, Bounds>* Stack;
+	ModifierId Id;
+};
+
+/*
+バフ・デバフを重ね掛けできるパラメーター
+元のパラメーター(UseDamageCalculationParameter)に加算の効果を合計して足し、乗算の効果を全て掛けた値を実際の値とする
+実際の値はキャッシュし、効果の追加・削除や元のパラメーターの変更があった時のみ再計算する
+効果の持続ターンはTimerWheelで管理するため、効果切れのないターンは効果の数に関係なく処理がほぼ発生しない
+
+TimerWheelは登録したModifierStackのアドレスを保持するため、コピー・移動はできない。登録した効果がある間は解放してはならない
+*/
+template<typename T, class Bounds = standard::dynamic_bounds<T>>
+class ModifierStack {
+public:
+	using Expiry = ModifierExpiry<T, Bounds>;
+	using Wheel = TimerWheel<Expiry>;
+private:
+	struct Modifier {
+		ModifierId Id;
+		ModifierType Type;
+		double Value;
+	};
+	UseDamageCalculationParameter<T, Bounds> Base;
+	std::vector<Modifier> Modifiers;
+	std::uint32_t NextId;
+	mutable T Effective;
+	mutable bool Dirty;
+	ModifierId Push(const ModifierType Type, const double Value) {
+		const ModifierId Id = static_cast<ModifierId>(this->NextId++);
+		if (this->NextId == static_cast<std::uint32_t>(ModifierId::Invalid)) this->NextId = 0;
+		this->Modifiers.push_back({ Id, Type, Value });
+		this->Dirty = true;
+		return Id;
+	}
+	T Recalculate() const {
+		double Add = 0.0, Mul = 1.0;
+		for (const Modifier& m : this->Modifiers) {
+			if (m.Type == ModifierType::Additive) Add += m.Value;
+			else Mul *= m.Value;
+		}
+		const double Result = (static_cast<double>(this->Base.Get()) + Add) * Mul;
+		// Tに変換する前にdoubleのまま範囲を判定する(範囲外の値やNaNの変換は未定義動作)
+		// 64bit整数の最大値はdoubleで正確に表せず切り上がるため、それ以上の値は変換せずに最大値とする。NaNは最小値とする
+		if (!(Result > static_cast<double>(this->Base.GetMin()))) return this->Base.GetMin();
+		if (Result >= static_cast<double>(this->Base.GetMax())) return this->Base.GetMax();
+		return static_cast<T>(Result);
+	}
+public:
+	ModifierStack(const UseDamageCalculationParameter<T, Bounds>& Base) : Base(Base), NextId(0), Effective(Base.Get()), Dirty(false) {}
+	ModifierStack(const ModifierStack&) = delete;
+	ModifierStack& operator = (const ModifierStack&) = delete;
+	ModifierStack(ModifierStack&&) = delete;
+	ModifierStack& operator = (ModifierStack&&) = delete;
+	// 効果を反映した値を取得する
+	T Get() const {
+		if (this->Dirty) {
+			this->Effective = this->Recalculate();
+			this->Dirty = false;
+		}
+		return this->Effective;
+	}
+	T operator * () const { return this->Get(); }
+	// 元のパラメーターを取得する
+	const UseDamageCalculationParameter<T, Bounds>& GetBase() const noexcept { return this->Base; }
+	// 掛かっている効果の数を取得する
+	size_t GetModifierNum() const noexcept { return this->Modifiers.size(); }
+	// 元のパラメーターを上げる
+	// 戻り値 : 実際に上がった値
+	T PowerUp(const T AddNum) {
+		this->Dirty = true;
+		return this->Base.PowerUp(AddNum);
+	}
+	// 元のパラメーターを下げる
+	// 戻り値 : 実際に下がった値
+	T PowerDown(const T SubtractNum) {
+		this->Dirty = true;
+		return this->Base.PowerDown(SubtractNum);
+	}
+	// 効果を追加する(効果切れなし)
+	// 第１引数 : 効果の種類
+	// 第２引数 : 加算の場合は加算値、乗算の場合は倍率
+	// 戻り値　 : 効果の識別子
+	ModifierId AddModifier(const ModifierType Type, const double Value) { return this->Push(Type, Value); }
+	// 効果を追加する
+	// 第３引数 : 効果が切れるターン(このターンにTimerWheelが進んだ時に削除される)
+	// 第４引数 : 効果切れを管理するTimerWheel
+	ModifierId AddModifier(const ModifierType Type, const double Value, const std::uint64_t ExpireTurn, Wheel& Timer) {
+		const ModifierId Id = this->Push(Type, Value);
+		Timer.Schedule(ExpireTurn, Expiry{ this, Id });
+		return Id;
+	}
+	// 効果を削除する。TimerWheelに登録されている効果を先に削除した場合、効果切れの時には何もしない
+	// 戻り値 : 効果が見つからなかった場合はfalse
+	bool RemoveModifier(const ModifierId Id) {
+		const auto it = std::find_if(this->Modifiers.begin(), this->Modifiers.end(), [Id](const Modifier& m) { return m.Id == Id; });
+		if (it == this->Modifiers.end()) return false;
+		this->Modifiers.erase(it);
+		this->Dirty = true;
+		return true;
+	}
+	// 全ての効果を削除する
+	void ClearModifiers() {
+		if (this->Modifiers.empty()) return;
+		this->Modifiers.clear();
+		this->Dirty = true;
+	}
+	// 全ての効果を削除し、元のパラメーターも元に戻す
+	void Reset() {
+		this->Modifiers.clear();
+		this->Base.Reset();
+		this->Dirty = true;
+	}
+	// TimerWheelを１ターン進め、効果が切れたものを削除する
+	static void AdvanceTurn(Wheel& Timer) {
+		Timer.Advance([](Expiry& e) { e.Stack->RemoveModifier(e.Id); });
+	}
+};
+#endif
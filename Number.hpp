@@ -1,10 +1,15 @@
 ﻿#ifndef __NUMBER_HPP__
 #define __NUMBER_HPP__
 #include <string>
+#include <string_view>
+#include <charconv>
 #include <type_traits>
 #include <limits>
 #include <algorithm>
 #include <cassert>
+#include <stdexcept>
+#include "Instrumentation.hpp"
+#include "Text.hpp"
 
 namespace standard {
 	template<typename T, class Compare> constexpr const T& clamp(const T& v, const T& lo, const T& hi, Compare comp) {
@@ -19,39 +24,220 @@ namespace standard {
 #endif
 	}
 
+	/*
+	飽和演算
+	結果がTの範囲を超える場合、折り返さずにTの最大値・最小値に丸める。浮動小数点数は通常の演算と同じ
+	GCC/Clangではオーバーフロー検出組み込み関数を、それ以外では符号ビットの判定または拡張した型での計算を使用し、
+	いずれも条件分岐ではなく選択命令になるように書いている
+	NUMBER_NO_BUILTIN_OVERFLOWを定義すると、GCC/Clangでも組み込み関数を使用しない実装になる(MSVCと同じ実装を検証するため)
+	*/
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(NUMBER_NO_BUILTIN_OVERFLOW)
+#define NUMBER_BUILTIN_OVERFLOW
+#endif
+	namespace {
+		// 符号付き整数の演算がオーバーフローした場合の値。正方向ならTの最大値、負方向ならTの最小値
+		template<typename T>
+		constexpr T saturated_value(const bool negative) noexcept {
+			using U = std::make_unsigned_t<T>;
+			return static_cast<T>(static_cast<U>(static_cast<U>(std::numeric_limits<T>::max()) + static_cast<U>(negative)));
+		}
+	}
+	template<typename T, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
+	constexpr T saturating_add(const T a, const T b) noexcept {
+		if constexpr (std::is_floating_point<T>::value) return a + b;
+		else {
+#ifdef NUMBER_BUILTIN_OVERFLOW
+			T r{};
+			const bool overflow = __builtin_add_overflow(a, b, &r);
+#else
+			using U = std::make_unsigned_t<T>;
+			const T r = static_cast<T>(static_cast<U>(a) + static_cast<U>(b));
+			const bool overflow = std::is_unsigned<T>::value ? r < a : ((a ^ r) & (b ^ r)) < 0;
+#endif
+			if constexpr (std::is_unsigned<T>::value) return static_cast<T>(r | static_cast<T>(-static_cast<T>(overflow)));
+			else return overflow ? saturated_value<T>(a < 0) : r;
+		}
+	}
+	template<typename T, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
+	constexpr T saturating_sub(const T a, const T b) noexcept {
+		if constexpr (std::is_floating_point<T>::value) return a - b;
+		else {
+#ifdef NUMBER_BUILTIN_OVERFLOW
+			T r{};
+			const bool overflow = __builtin_sub_overflow(a, b, &r);
+#else
+			using U = std::make_unsigned_t<T>;
+			const T r = static_cast<T>(static_cast<U>(a) - static_cast<U>(b));
+			const bool overflow = std::is_unsigned<T>::value ? a < b : ((a ^ b) & (a ^ r)) < 0;
+#endif
+			if constexpr (std::is_unsigned<T>::value) return static_cast<T>(r & static_cast<T>(static_cast<T>(overflow) - 1));
+			else return overflow ? saturated_value<T>(a < 0) : r;
+		}
+	}
+	template<typename T, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
+	constexpr T saturating_mul(const T a, const T b) noexcept {
+		if constexpr (std::is_floating_point<T>::value) return a * b;
+		else {
+#ifdef NUMBER_BUILTIN_OVERFLOW
+			T r{};
+			const bool overflow = __builtin_mul_overflow(a, b, &r);
+#else
+			T r{};
+			bool overflow = false;
+			if constexpr (sizeof(T) < sizeof(long long)) {
+				using Wide = std::conditional_t<std::is_signed<T>::value, long long, unsigned long long>;
+				const Wide w = static_cast<Wide>(a) * static_cast<Wide>(b);
+				overflow = w > static_cast<Wide>(std::numeric_limits<T>::max()) || w < static_cast<Wide>(std::numeric_limits<T>::min());
+				r = static_cast<T>(w);
+			}
+			else {
+				using U = std::make_unsigned_t<T>;
+				r = static_cast<T>(static_cast<U>(a) * static_cast<U>(b));
+				// a == -1の場合はr / aがTの最小値 / -1になり得るため、除算せずに判定する
+				if constexpr (std::is_signed<T>::value) overflow = a == -1 ? b == std::numeric_limits<T>::min() : a != 0 && r / a != b;
+				else overflow = a != 0 && r / a != b;
+			}
+#endif
+			if constexpr (std::is_unsigned<T>::value) return static_cast<T>(r | static_cast<T>(-static_cast<T>(overflow)));
+			else return overflow ? saturated_value<T>((a < 0) != (b < 0)) : r;
+		}
+	}
+	// 0による除算は通常の除算と同様に未定義
 	template<typename T, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
-	class number {
+	constexpr T saturating_div(const T a, const T b) noexcept {
+		if constexpr (std::is_signed<T>::value && std::is_integral<T>::value) {
+			// Tの最小値 / -1 のみオーバーフローする
+			return a == std::numeric_limits<T>::min() && b == -1 ? std::numeric_limits<T>::max() : static_cast<T>(a / b);
+		}
+		else return static_cast<T>(a / b);
+	}
+	// 配列の各要素に飽和加算する(Dst[i] = Dst[i] + Src[i])
+	template<typename T, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
+	void saturating_add(T* Dst, const T* Src, const size_t Num) noexcept {
+		for (size_t i = 0; i < Num; i++) Dst[i] = saturating_add(Dst[i], Src[i]);
+	}
+	// 配列の各要素に飽和加算し、最大値と最小値の範囲に収める
+	template<typename T, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
+	void saturating_add(T* Dst, const T* Src, const size_t Num, const T Max, const T Min) noexcept {
+		for (size_t i = 0; i < Num; i++) Dst[i] = clamp(saturating_add(Dst[i], Src[i]), Min, Max);
+	}
+	// 配列の各要素から飽和減算する(Dst[i] = Dst[i] - Src[i])
+	template<typename T, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
+	void saturating_sub(T* Dst, const T* Src, const size_t Num) noexcept {
+		for (size_t i = 0; i < Num; i++) Dst[i] = saturating_sub(Dst[i], Src[i]);
+	}
+	// 配列の各要素から飽和減算し、最大値と最小値の範囲に収める
+	template<typename T, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
+	void saturating_sub(T* Dst, const T* Src, const size_t Num, const T Max, const T Min) noexcept {
+		for (size_t i = 0; i < Num; i++) Dst[i] = clamp(saturating_sub(Dst[i], Src[i]), Min, Max);
+	}
+
+	// 最大値・最小値をインスタンス毎に保持するポリシー(numberの既定)
+	template<typename T>
+	class dynamic_bounds {
 	private:
-		T n, maximum, minimum;
+		T maximum, minimum;
+	public:
+		static constexpr bool is_dynamic = true;
+		dynamic_bounds() = default;
+		constexpr dynamic_bounds(const T max, const T min) : maximum(max), minimum(min) {}
+		// 最大値・最小値を指定せずに作成した場合の範囲
+		static constexpr dynamic_bounds initial() noexcept { return dynamic_bounds(std::numeric_limits<T>::max(), std::numeric_limits<T>::min()); }
+		constexpr T max() const noexcept { return this->maximum; }
+		constexpr T min() const noexcept { return this->minimum; }
+		void set_max(const T num) noexcept { this->maximum = num; }
+		void set_min(const T num) noexcept { this->minimum = num; }
+	};
+	// 最大値・最小値をコンパイル時定数とするポリシー。numberのサイズはsizeof(T)になる
+	// 浮動小数点数はテンプレート引数にできないため、整数のみ使用できる。最大値・最小値は変更できない
+	template<typename T, T Max, T Min>
+	class static_bounds {
+		static_assert(Min <= Max, "Max must be larger than Min.");
+	public:
+		static constexpr bool is_dynamic = false;
+		static constexpr static_bounds initial() noexcept { return static_bounds(); }
+		static constexpr T max() noexcept { return Max; }
+		static constexpr T min() noexcept { return Min; }
+	};
+	// 最大値・最小値をTag毎に共有するポリシー。numberのサイズはsizeof(T)になる
+	// 最大値・最小値はset_boundsで全インスタンス一括でのみ変更できる。既存のインスタンスの現在値は範囲内に収め直されないため、起動時に設定すること
+	template<typename T, class Tag>
+	class shared_bounds {
+	private:
+		static inline T maximum = std::numeric_limits<T>::max();
+		static inline T minimum = std::numeric_limits<T>::min();
+	public:
+		static constexpr bool is_dynamic = false;
+		static constexpr shared_bounds initial() noexcept { return shared_bounds(); }
+		static T max() noexcept { return maximum; }
+		static T min() noexcept { return minimum; }
+		// 例外 : 最大値が最小値より小さい場合、std::runtime_errorが投げられる
+		static void set_bounds(const T max, const T min) {
+			if (max < min) throw std::runtime_error("maximum must be larger than minimum.");
+			maximum = max;
+			minimum = min;
+		}
+	};
+
+	// 第２テンプレート引数 : 最大値・最小値の保持方法(dynamic_bounds、static_bounds、shared_bounds)
+	template<typename T, class Bounds = dynamic_bounds<T>>
+	class number : private Bounds {
+		static_assert(std::is_arithmetic<T>::value, "T must be arithmetic type.");
+	private:
+		T n;
+#ifdef STATUS_INSTRUMENTATION
+		Instrumentation::StatKind stat_kind = Instrumentation::StatKind::Number;
+#endif
+		constexpr const Bounds& bounds() const noexcept { return *this; }
+		constexpr number(const T num, const Bounds& b) : Bounds(b), n(clamp(num, b.min(), b.max())) {}
+		// 演算結果を作成する。最大値・最小値と計測時の種類は左辺から引き継ぐ
+		constexpr number derive(const T num) const {
+			number result(num, this->bounds());
+#ifdef STATUS_INSTRUMENTATION
+			result.stat_kind = this->stat_kind;
+#endif
+			return result;
+		}
+		// 現在値を最大値と最小値の範囲に収めて変更する。STATUS_INSTRUMENTATIONが定義されている場合は変更を記録する
+		void update(const T num) {
+			const T before = this->n;
+			this->n = this->cmp(num);
+			STATUS_INSTRUMENT_MUTATION(this, this->stat_kind, before, this->n, num, this->GetMax(), this->GetMin());
+			static_cast<void>(before);
+		}
 	protected:
-		T cmp(const T num) {
-			return clamp(num, this->minimum, this->maximum);
+		T cmp(const T num) const {
+			return clamp(num, this->GetMin(), this->GetMax());
 		}
 	public:
 		number() = default;
-		constexpr number(const T num, const T max, const T min) : n(clamp(num, min, max)), maximum(max), minimum(min) {}
-		constexpr number(const T num) : number(num, std::numeric_limits<T>::max(), std::numeric_limits<T>::min()) {}
-		number& operator + (const number& num) const { return number(clamp(this->n + num.n, this->minimum, this->maximum), this->maximum, this->minimum); }
-		number& operator - (const number& num) const { return number(clamp(this->n - num.n, this->minimum, this->maximum), this->maximum, this->minimum); }
-		number& operator * (const number& num) const { return number(clamp(this->n * num.n, this->minimum, this->maximum), this->maximum, this->minimum); }
-		number& operator / (const number& num) const { return number(clamp(this->n / num.n, this->minimum, this->maximum), this->maximum, this->minimum); }
-		number& operator & (const number& num) const { return number(clamp(this->n & num.n, this->minimum, this->maximum), this->maximum, this->minimum); }
-		number& operator % (const number& num) const { return number(clamp(this->n % num.n, this->minimum, this->maximum), this->maximum, this->minimum); }
-		number& operator | (const number& num) const { return number(clamp(this->n | num.n, this->minimum, this->maximum), this->maximum, this->minimum); }
-		number& operator ^ (const number& num) const { return number(clamp(this->n ^ num.n, this->minimum, this->maximum), this->maximum, this->minimum); }
-		number& operator << (const number& num) const { return number(clamp(this->n << num.n, this->minimum, this->maximum), this->maximum, this->minimum); }
-		number& operator >> (const number& num) const { return number(clamp(this->n >> num.n, this->minimum, this->maximum), this->maximum, this->minimum); }
-		number& operator += (const number& num) { this->n = this->cmp(this->n + num.n); return *this; }
-		number& operator ++ () { this->n = this->cmp(this->n + 1); return *this; }
-		number& operator -= (const number& num) { this->n = this->cmp(this->n - num.n); return *this; }
-		number& operator -- () { this->n = this->cmp(this->n - 1); return *this; }
-		number& operator *= (const number& num) { this->n = this->cmp(this->n = num.n); return *this; }
-		number& operator /= (const number& num) { this->n = this->cmp(this->n = num.n); return *this; }
-		number& operator &= (const number& num) { this->n = this->cmp(this->n & num.n); return *this; }
-		number& operator %= (const number& num) { this->n = this->cmp(this->n % num.n); return *this; }
-		number& operator |= (const number& num) { this->n = this->cmp(this->n | num.n); return *this; }
-		number& operator <<= (const number& num) { this->n = this->cmp(this->n << num.n); return *this; }
-		number& operator >>= (const number& num) { this->n = this->cmp(this->n >> num.n); return *this; }
+		template<class B = Bounds, std::enable_if_t<B::is_dynamic, std::nullptr_t> = nullptr>
+		constexpr number(const T num, const T max, const T min) : Bounds(max, min), n(clamp(num, min, max)) {}
+		constexpr number(const T num) : number(num, Bounds::initial()) {}
+		number operator + (const number& num) const { return this->derive(saturating_add(this->n, num.n)); }
+		number operator - (const number& num) const { return this->derive(saturating_sub(this->n, num.n)); }
+		number operator * (const number& num) const { return this->derive(saturating_mul(this->n, num.n)); }
+		number operator / (const number& num) const { return this->derive(saturating_div(this->n, num.n)); }
+		number operator & (const number& num) const { return this->derive(static_cast<T>(this->n & num.n)); }
+		number operator % (const number& num) const { return this->derive(static_cast<T>(this->n % num.n)); }
+		number operator | (const number& num) const { return this->derive(static_cast<T>(this->n | num.n)); }
+		number operator ^ (const number& num) const { return this->derive(static_cast<T>(this->n ^ num.n)); }
+		number operator << (const number& num) const { return this->derive(static_cast<T>(this->n << num.n)); }
+		number operator >> (const number& num) const { return this->derive(static_cast<T>(this->n >> num.n)); }
+		// 右辺を数値で受け取る複合代入演算子。右辺が左辺の最大値・最小値で丸められないため、範囲が固定されたポリシーでも右辺の値がそのまま使われる
+		number& operator += (const T num) { this->update(saturating_add(this->n, num)); return *this; }
+		number& operator -= (const T num) { this->update(saturating_sub(this->n, num)); return *this; }
+		number& operator += (const number& num) { return *this += num.n; }
+		number& operator ++ () { this->update(saturating_add(this->n, static_cast<T>(1))); return *this; }
+		number& operator -= (const number& num) { return *this -= num.n; }
+		number& operator -- () { this->update(saturating_sub(this->n, static_cast<T>(1))); return *this; }
+		number& operator *= (const number& num) { this->update(saturating_mul(this->n, num.n)); return *this; }
+		number& operator /= (const number& num) { this->update(saturating_div(this->n, num.n)); return *this; }
+		number& operator &= (const number& num) { this->update(this->n & num.n); return *this; }
+		number& operator %= (const number& num) { this->update(this->n % num.n); return *this; }
+		number& operator |= (const number& num) { this->update(this->n | num.n); return *this; }
+		number& operator <<= (const number& num) { this->update(this->n << num.n); return *this; }
+		number& operator >>= (const number& num) { this->update(this->n >> num.n); return *this; }
 		bool operator == (const number& num) const { return this->n == num.n; }
 		bool operator != (const number& num) const { return this->n != num.n; }
 		bool operator <  (const number& num) const { return this->n < num.n; }
@@ -62,31 +248,42 @@ namespace standard {
 		operator number<U>() {
 			return number<U>(
 				this->n,
-				this->maximum >= std::numeric_limits<U>::max() ? std::numeric_limits<U>::max() : this->maximum,
-				this->minimum <= std::numeric_limits<U>::min() ? std::numeric_limits<U>::min() : this->minimum
+				this->GetMax() >= std::numeric_limits<U>::max() ? std::numeric_limits<U>::max() : this->GetMax(),
+				this->GetMin() <= std::numeric_limits<U>::min() ? std::numeric_limits<U>::min() : this->GetMin()
 				);
 		}
 		// 現在値を取得する
 		T Get() const noexcept { return this->n; }
+		// 計測時のパラメーターの種類を設定する。派生クラスは自身の種類を設定する(STATUS_INSTRUMENTATIONが定義されていない場合は何もしない)
+		constexpr void SetStatKind(const Instrumentation::StatKind kind) noexcept {
+#ifdef STATUS_INSTRUMENTATION
+			this->stat_kind = kind;
+#else
+			static_cast<void>(kind);
+#endif
+		}
 		// 設定されている現在の最大値を取得する
-		T GetMax() const noexcept { return this->maximum; }
+		T GetMax() const noexcept { return this->bounds().max(); }
 		// 設定されている現在の最大値を取得する
-		T GetMin() const noexcept { return this->minimum; }
+		T GetMin() const noexcept { return this->bounds().min(); }
 		// 現在値を指定された値に変更する
-		void ChangeCurrentNumToReserevedNum(const T num) { this->n = num; }
-		// 最大値を指定された値に変更する
+		void ChangeCurrentNumToReserevedNum(const T num) {
+			STATUS_INSTRUMENT_SET(this, this->stat_kind, this->n, num);
+			this->n = num;
+		}
+		// 最大値を指定された値に変更する(dynamic_boundsのみ)
 		// 例外 : 引数に指定された値が現在の最小値より小さい場合、std::runtime_errorが投げられる
 		void ChangeMaximumToReservedNum(const T num) {
-			if (num < this->minimum) throw std::runtime_error("maximum must be larger than minimum.");
-			this->maximum = num;
-			this->n = this->cmp(this->n);
+			if (num < this->GetMin()) throw std::runtime_error("maximum must be larger than minimum.");
+			this->Bounds::set_max(num);
+			this->update(this->n);
 		}
-		// 最小値を指定された値に変更する
+		// 最小値を指定された値に変更する(dynamic_boundsのみ)
 		// 例外 : 引数に指定された値が現在の最大値より大きい場合、std::runtime_errorが投げられる
 		void ChangeMinimumToReservedNum(const T num) {
-			if (num > this->maximum) throw std::runtime_error("minimum must be smaller than maximum.");
-			this->minimum = num;
-			this->n = this->cmp(this->n);
+			if (num > this->GetMax()) throw std::runtime_error("minimum must be smaller than maximum.");
+			this->Bounds::set_min(num);
+			this->update(this->n);
 		}
 		// 最大値に指定された値を加算する
 		// 例外 : 引数に指定された値が負の場合、計算することによって最大値が最小値を下回る場合、std::runtime_errorが投げられる
@@ -96,66 +293,66 @@ namespace standard {
 		void AddToMin(const T num) { this->ChangeMinimumToReservedNum(this->GetMin() + num); }
 	};
 	template<typename T, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
-	constexpr const number<T>& clamp(const number<T>& v, const number<T>& lo, const number<T>& hi) { return number<T>(clamp<T>(v.Get(), lo.Get(), hi.Get())); }
+	constexpr number<T> clamp(const number<T>& v, const number<T>& lo, const number<T>& hi) { return number<T>(clamp<T>(v.Get(), lo.Get(), hi.Get())); }
 	template<typename T, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
-	constexpr const number<T>& clamp(const T& v, const number<T>& lo, const number<T>& hi) { return number<T>(clamp<T>(v.Get(), lo.Get(), hi.Get())); }
+	constexpr number<T> clamp(const T& v, const number<T>& lo, const number<T>& hi) { return number<T>(clamp<T>(v, lo.Get(), hi.Get())); }
 	template<typename T, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
-	constexpr const number<T>& clamp(const number<T>& v, const T& lo, const number<T>& hi) { return number<T>(clamp<T>(v.Get(), lo.Get(), hi.Get())); }
+	constexpr number<T> clamp(const number<T>& v, const T& lo, const number<T>& hi) { return number<T>(clamp<T>(v.Get(), lo, hi.Get())); }
 	template<typename T, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
-	constexpr const number<T>& clamp(const number<T>& v, const number<T>& lo, const T& hi) { return number<T>(clamp<T>(v.Get(), lo.Get(), hi)); }
+	constexpr number<T> clamp(const number<T>& v, const number<T>& lo, const T& hi) { return number<T>(clamp<T>(v.Get(), lo.Get(), hi)); }
 	template<typename T, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
-	constexpr const number<T>& clamp(const T& v, const T& lo, const number<T>& hi) { return number<T>(clamp<T>(v.Get(), lo.Get(), hi.Get())); }
+	constexpr number<T> clamp(const T& v, const T& lo, const number<T>& hi) { return number<T>(clamp<T>(v, lo, hi.Get())); }
 	template<typename T, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
-	constexpr const number<T>& clamp(const T& v, const number<T>& lo, const T& hi) { return number<T>(clamp<T>(v.Get(), lo.Get(), hi.Get())); }
+	constexpr number<T> clamp(const T& v, const number<T>& lo, const T& hi) { return number<T>(clamp<T>(v, lo.Get(), hi)); }
 	template<typename T, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
-	constexpr const number<T>& clamp(const number<T>& v, const T& lo, const T& hi) { return number<T>(clamp<T>(v.Get(), lo.Get(), hi.Get())); }
+	constexpr number<T> clamp(const number<T>& v, const T& lo, const T& hi) { return number<T>(clamp<T>(v.Get(), lo, hi)); }
 
 	template<typename T, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
-	inline number<T>& operator + (const T& n, const number<T>& num) { return number<T>(clamp(n + num.Get(), num.GetMin(), num.GetMax()), num.GetMax(), num.GetMin()); }
-	template<typename T, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
-	inline number<T>& operator - (const T& n, const number<T>& num) { return number<T>(clamp(n - num.Get(), num.GetMin(), num.GetMax()), num.GetMax(), num.GetMin()); }
-	template<typename T, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
-	inline number<T>& operator * (const T& n, const number<T>& num) { return number<T>(clamp(n * num.Get(), num.GetMin(), num.GetMax()), num.GetMax(), num.GetMin()); }
-	template<typename T, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
-	inline number<T>& operator / (const T& n, const number<T>& num) { return number<T>(clamp(n / num.Get(), num.GetMin(), num.GetMax()), num.GetMax(), num.GetMin()); }
-	template<typename T, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
-	inline number<T>& operator & (const T& n, const number<T>& num) { return number<T>(clamp(n & num.Get(), num.GetMin(), num.GetMax()), num.GetMax(), num.GetMin()); }
-	template<typename T, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
-	inline number<T>& operator % (const T& n, const number<T>& num) { return number<T>(clamp(n % num.Get(), num.GetMin(), num.GetMax()), num.GetMax(), num.GetMin()); }
+	inline number<T> operator + (const T& n, const number<T>& num) { return number<T>(saturating_add(n, num.Get()), num.GetMax(), num.GetMin()); }
 	template<typename T, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
-	inline number<T>& operator | (const T& n, const number<T>& num) { return number<T>(clamp(n | num.Get(), num.GetMin(), num.GetMax()), num.GetMax(), num.GetMin()); }
+	inline number<T> operator - (const T& n, const number<T>& num) { return number<T>(saturating_sub(n, num.Get()), num.GetMax(), num.GetMin()); }
 	template<typename T, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
-	inline number<T>& operator ^ (const T& n, const number<T>& num) { return number<T>(clamp(n ^ num.Get(), num.GetMin(), num.GetMax()), num.GetMax(), num.GetMin()); }
+	inline number<T> operator * (const T& n, const number<T>& num) { return number<T>(saturating_mul(n, num.Get()), num.GetMax(), num.GetMin()); }
 	template<typename T, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
-	inline number<T>& operator << (const T& n, const number<T>& num) { return number<T>(clamp(n << num.Get(), num.GetMin(), num.GetMax()), num.GetMax(), num.GetMin()); }
+	inline number<T> operator / (const T& n, const number<T>& num) { return number<T>(saturating_div(n, num.Get()), num.GetMax(), num.GetMin()); }
 	template<typename T, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
-	inline number<T>& operator >> (const T& n, const number<T>& num) { return number<T>(clamp(n >> num.Get(), num.GetMin(), num.GetMax()), num.GetMax(), num.GetMin()); }
+	inline number<T> operator & (const T& n, const number<T>& num) { return number<T>(static_cast<T>(n & num.Get()), num.GetMax(), num.GetMin()); }
 	template<typename T, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
-	inline bool operator == (const T& n, const number<T>& num) { return n == num.Get(); }
+	inline number<T> operator % (const T& n, const number<T>& num) { return number<T>(static_cast<T>(n % num.Get()), num.GetMax(), num.GetMin()); }
 	template<typename T, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
-	inline bool operator != (const T& n, const number<T>& num) { return n != num.Get(); }
+	inline number<T> operator | (const T& n, const number<T>& num) { return number<T>(static_cast<T>(n | num.Get()), num.GetMax(), num.GetMin()); }
 	template<typename T, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
-	inline bool operator <  (const T& n, const number<T>& num) { return n < num.Get(); }
+	inline number<T> operator ^ (const T& n, const number<T>& num) { return number<T>(static_cast<T>(n ^ num.Get()), num.GetMax(), num.GetMin()); }
 	template<typename T, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
-	inline bool operator <= (const T& n, const number<T>& num) { return n <= num.Get(); }
+	inline number<T> operator << (const T& n, const number<T>& num) { return number<T>(static_cast<T>(n << num.Get()), num.GetMax(), num.GetMin()); }
 	template<typename T, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
-	inline bool operator >  (const T& n, const number<T>& num) { return n > num.Get(); }
-	template<typename T, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
-	inline bool operator >= (const T& n, const number<T>& num) { return n >= num.Get(); }
+	inline number<T> operator >> (const T& n, const number<T>& num) { return number<T>(static_cast<T>(n >> num.Get()), num.GetMax(), num.GetMin()); }
+	template<typename T, class Bounds, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
+	inline bool operator == (const T& n, const number<T, Bounds>& num) { return n == num.Get(); }
+	template<typename T, class Bounds, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
+	inline bool operator != (const T& n, const number<T, Bounds>& num) { return n != num.Get(); }
+	template<typename T, class Bounds, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
+	inline bool operator <  (const T& n, const number<T, Bounds>& num) { return n < num.Get(); }
+	template<typename T, class Bounds, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
+	inline bool operator <= (const T& n, const number<T, Bounds>& num) { return n <= num.Get(); }
+	template<typename T, class Bounds, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
+	inline bool operator >  (const T& n, const number<T, Bounds>& num) { return n > num.Get(); }
+	template<typename T, class Bounds, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
+	inline bool operator >= (const T& n, const number<T, Bounds>& num) { return n >= num.Get(); }
 
 	template<typename T, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
-	constexpr const number<T>& max(const number<T>& Left, const number<T>& Right) { return number<T>(std::max(Left.Get(), Right.Get())); }
+	constexpr number<T> max(const number<T>& Left, const number<T>& Right) { return number<T>(std::max(Left.Get(), Right.Get())); }
 	template<typename T, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
-	constexpr const number<T>& max(const number<T>& Left, const T& Right) { return number<T>(std::max(Left.Get(), Right)); }
+	constexpr number<T> max(const number<T>& Left, const T& Right) { return number<T>(std::max(Left.Get(), Right)); }
 	template<typename T, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
-	constexpr const number<T>& max(const T& Left, const number<T>& Right) { return number<T>(std::max(Left, Right.Get())); }
+	constexpr number<T> max(const T& Left, const number<T>& Right) { return number<T>(std::max(Left, Right.Get())); }
 
 	template<typename T, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
-	constexpr const number<T>& min(const number<T>& Left, const number<T>& Right) { return number<T>(std::min(Left.Get(), Right.Get())); }
+	constexpr number<T> min(const number<T>& Left, const number<T>& Right) { return number<T>(std::min(Left.Get(), Right.Get())); }
 	template<typename T, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
-	constexpr const number<T>& min(const number<T>& Left, const T& Right) { return number<T>(std::min(Left.Get(), Right)); }
+	constexpr number<T> min(const number<T>& Left, const T& Right) { return number<T>(std::min(Left.Get(), Right)); }
 	template<typename T, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
-	constexpr const number<T>& min(const T& Left, const number<T>& Right) { return number<T>(std::min(Left, Right.Get())); }
+	constexpr number<T> min(const T& Left, const number<T>& Right) { return number<T>(std::min(Left, Right.Get())); }
 
 	inline number<long double> abs(const number<long double> n) { return number<long double>(std::abs(n.Get())); }
 	inline number<double> abs(const number<double> n) { return number<double>(std::abs(n.Get())); }
@@ -164,37 +361,85 @@ namespace standard {
 	inline number<long> abs(const number<long> n) { return number<long>(std::abs(n.Get())); }
 	inline number<int> abs(const number<int> n) { return number<int>(std::abs(n.Get())); }
 
-	namespace {
-		template<typename T, std::enable_if_t<std::is_signed<T>::value, std::nullptr_t> = nullptr>
-		number<T> string_to_signed_integer(const std::string& s, size_t* Index = 0, const int Base = 10) { return number<T>(static_cast<T>(std::stoll(s, Index, Base))); }
-		template<typename T, std::enable_if_t<std::is_signed<T>::value, std::nullptr_t> = nullptr>
-		number<T> wstring_to_signed_integer(const std::wstring& s, size_t* Index = 0, const int Base = 10) { return number<T>(static_cast<T>(std::stoll(s, Index, Base))); }
-		template<typename T, std::enable_if_t<std::is_unsigned<T>::value, std::nullptr_t> = nullptr>
-		number<T> string_to_unsigned_integer(const std::string& s, size_t* Index = 0, const int Base = 10) { return number<T>(static_cast<T>(std::stoull(s, Index, Base))); }
-		template<typename T, std::enable_if_t<std::is_unsigned<T>::value, std::nullptr_t> = nullptr>
-		number<T> wstring_to_unsigned_integer(const std::wstring& s, size_t* Index = 0, const int Base = 10) { return number<T>(static_cast<T>(std::stoull(s, Index, Base))); }
-		template<typename T, std::enable_if_t<std::is_floating_point<T>::value, std::nullptr_t> = nullptr>
-		number<T> string_to_float(const std::string s, size_t* Index = 0) { return number<T>(static_cast<T>(std::stold(s, Index))); }
-		template<typename T, std::enable_if_t<std::is_floating_point<T>::value, std::nullptr_t> = nullptr>
-		number<T> wstring_to_float(const std::wstring s, size_t* Index = 0) { return number<T>(static_cast<T>(std::stold(s, Index))); }
+	namespace internal {
+		// std::basic_stringはそのまま参照し、それ以外の文字列はstd::basic_stringを作成する
+		template<typename CharT>
+		const std::basic_string<CharT>& as_string(const std::basic_string<CharT>& s) noexcept { return s; }
+		template<class Text, class CharT = text_char_t<Text>>
+		std::basic_string<CharT> as_string(const Text& s) { return std::basic_string<CharT>(to_string_view(s)); }
+		template<typename T, typename CharT, std::enable_if_t<std::is_signed<T>::value, std::nullptr_t> = nullptr>
+		number<T> string_to_signed_integer(const std::basic_string<CharT>& s, size_t* Index = 0, const int Base = 10) { return number<T>(static_cast<T>(std::stoll(s, Index, Base))); }
+		template<typename T, typename CharT, std::enable_if_t<std::is_unsigned<T>::value, std::nullptr_t> = nullptr>
+		number<T> string_to_unsigned_integer(const std::basic_string<CharT>& s, size_t* Index = 0, const int Base = 10) { return number<T>(static_cast<T>(std::stoull(s, Index, Base))); }
+		template<typename T, typename CharT, std::enable_if_t<std::is_floating_point<T>::value, std::nullptr_t> = nullptr>
+		number<T> string_to_float(const std::basic_string<CharT>& s, size_t* Index = 0) { return number<T>(static_cast<T>(std::stold(s, Index))); }
+	}
+	// 引数の文字列はstd::string、std::wstring、文字列リテラル等(std::stoll等と同じく、charとwchar_tのみ対応)
+	template<class Text, class = text_char_t<Text>>
+	number<int> stoi(const Text& s, size_t* Index = 0, const int Base = 10) { return internal::string_to_signed_integer<int>(internal::as_string(s), Index, Base); }
+	template<class Text, class = text_char_t<Text>>
+	number<long> stol(const Text& s, size_t* Index = 0, const int Base = 10) { return internal::string_to_signed_integer<long>(internal::as_string(s), Index, Base); }
+	template<class Text, class = text_char_t<Text>>
+	number<long long> stoll(const Text& s, size_t* Index = 0, const int Base = 10) { return internal::string_to_signed_integer<long long>(internal::as_string(s), Index, Base); }
+	template<class Text, class = text_char_t<Text>>
+	number<unsigned int> stoui(const Text& s, size_t* Index = 0, const int Base = 10) { return internal::string_to_unsigned_integer<unsigned int>(internal::as_string(s), Index, Base); }
+	template<class Text, class = text_char_t<Text>>
+	number<unsigned long> stoul(const Text& s, size_t* Index = 0, const int Base = 10) { return internal::string_to_unsigned_integer<unsigned long>(internal::as_string(s), Index, Base); }
+	template<class Text, class = text_char_t<Text>>
+	number<unsigned long long> stoull(const Text& s, size_t* Index = 0, const int Base = 10) { return internal::string_to_unsigned_integer<unsigned long long>(internal::as_string(s), Index, Base); }
+	template<class Text, class = text_char_t<Text>>
+	number<float> stof(const Text& s, size_t* Index = 0) { return internal::string_to_float<float>(internal::as_string(s), Index); }
+	template<class Text, class = text_char_t<Text>>
+	number<double> stod(const Text& s, size_t* Index = 0) { return internal::string_to_float<double>(internal::as_string(s), Index); }
+	template<class Text, class = text_char_t<Text>>
+	number<long double> stold(const Text& s, size_t* Index = 0) { return internal::string_to_float<long double>(internal::as_string(s), Index); }
+
+	namespace internal {
+		// char以外の文字列の数値部分をchar型のバッファに写す。数値に使われない文字が含まれる場合はfalseを返す
+		template<typename CharT, size_t BufferSize>
+		bool narrow_number_string(const std::basic_string_view<CharT> s, char(&Buffer)[BufferSize]) noexcept {
+			if (s.size() > BufferSize) return false;
+			for (size_t i = 0; i < s.size(); i++) {
+				if (static_cast<std::make_unsigned_t<CharT>>(s[i]) >= 0x80) return false;
+				Buffer[i] = static_cast<char>(s[i]);
+			}
+			return true;
+		}
+		template<typename CharT, typename T, class... Base>
+		std::errc parse_number(const std::basic_string_view<CharT> s, T& Result, const Base... Args) noexcept {
+			if constexpr (!std::is_same<CharT, char>::value) {
+				char Buffer[128];
+				if (!narrow_number_string(s, Buffer)) return std::errc::invalid_argument;
+				return parse_number(std::string_view(Buffer, s.size()), Result, Args...);
+			}
+			else {
+				T Value{};
+				const std::from_chars_result r = std::from_chars(s.data(), s.data() + s.size(), Value, Args...);
+				if (r.ec != std::errc()) return r.ec;
+				if (r.ptr != s.data() + s.size()) return std::errc::invalid_argument;
+				Result = Value;
+				return std::errc();
+			}
+		}
+	}
+	// 文字列全体を整数に変換する。例外を投げず、メモリの確保も行わない
+	// 引数の文字列は文字型を問わない(char以外はASCIIの範囲のみ受け付け、charに写してから変換する)
+	// 先頭の空白及び'+'は受け付けない。失敗した場合、Resultは変更されない
+	// 戻り値 : 成功した場合はstd::errc()、数値でない文字が含まれる場合はstd::errc::invalid_argument、Tの範囲を超える場合はstd::errc::result_out_of_range
+	template<class Text, typename T, class CharT = text_char_t<Text>, std::enable_if_t<std::is_integral<T>::value && !std::is_same<T, bool>::value, std::nullptr_t> = nullptr>
+	std::errc parse(const Text& s, T& Result, const int Base = 10) noexcept { return internal::parse_number(to_string_view(s), Result, Base); }
+	// 文字列全体を浮動小数点数に変換する。例外を投げず、メモリの確保も行わない
+	// 先頭の空白及び'+'は受け付けない。失敗した場合、Resultは変更されない
+	// 戻り値 : 成功した場合はstd::errc()、数値でない文字が含まれる場合はstd::errc::invalid_argument、Tの範囲を超える場合はstd::errc::result_out_of_range
+	template<class Text, typename T, class CharT = text_char_t<Text>, std::enable_if_t<std::is_floating_point<T>::value, std::nullptr_t> = nullptr>
+	std::errc parse(const Text& s, T& Result) noexcept { return internal::parse_number(to_string_view(s), Result); }
+	// 文字列全体を数値に変換し、Resultに設定されている最大値と最小値の範囲に収めて設定する
+	template<class Text, typename T, class CharT = text_char_t<Text>, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
+	std::errc parse(const Text& s, number<T>& Result) noexcept {
+		T Value{};
+		const std::errc ec = parse(s, Value);
+		if (ec == std::errc()) Result = number<T>(Value, Result.GetMax(), Result.GetMin());
+		return ec;
 	}
-	inline number<int> stoi(const std::string& s, size_t* Index = 0, const int Base = 10) { return string_to_signed_integer<int>(s, Index, Base); }
-	inline number<int> stoi(const std::wstring& s, size_t* Index = 0, const int Base = 10) { return wstring_to_signed_integer<int>(s, Index, Base); }
-	inline number<long> stol(const std::string& s, size_t* Index = 0, const int Base = 10) { return string_to_signed_integer<long>(s, Index, Base); }
-	inline number<long> stol(const std::wstring& s, size_t* Index = 0, const int Base = 10) { return wstring_to_signed_integer<long>(s, Index, Base); }
-	inline number<__int64> stoll(const std::string& s, size_t* Index = 0, const int Base = 10) { return string_to_signed_integer<__int64>(s, Index, Base); }
-	inline number<__int64> stoll(const std::wstring& s, size_t* Index = 0, const int Base = 10) { return wstring_to_signed_integer<__int64>(s, Index, Base); }
-	inline number<unsigned int> stoui(const std::string& s, size_t* Index = 0, const int Base = 10) { return string_to_unsigned_integer<unsigned int>(s, Index, Base); }
-	inline number<unsigned int> stoui(const std::wstring& s, size_t* Index = 0, const int Base = 10) { return wstring_to_unsigned_integer<unsigned int>(s, Index, Base); }
-	inline number<unsigned long> stoul(const std::string& s, size_t* Index = 0, const int Base = 10) { return string_to_unsigned_integer<unsigned long>(s, Index, Base); }
-	inline number<unsigned long> stoul(const std::wstring& s, size_t* Index = 0, const int Base = 10) { return wstring_to_unsigned_integer<unsigned long>(s, Index, Base); }
-	inline number<unsigned __int64> stoull(const std::string& s, size_t* Index = 0, const int Base = 10) { return string_to_unsigned_integer<unsigned __int64>(s, Index, Base); }
-	inline number<unsigned __int64> stoull(const std::wstring& s, size_t* Index = 0, const int Base = 10) { return wstring_to_unsigned_integer<unsigned __int64>(s, Index, Base); }
-	inline number<float> stof(const std::string& s, size_t* Index = 0) { return string_to_float<float>(s, Index); }
-	inline number<float> stof(const std::wstring& s, size_t* Index = 0) { return wstring_to_float<float>(s, Index); }
-	inline number<double> stod(const std::string& s, size_t* Index = 0) { return string_to_float<double>(s, Index); }
-	inline number<double> stod(const std::wstring& s, size_t* Index = 0) { return wstring_to_float<double>(s, Index); }
-	inline number<long double> stold(const std::string& s, size_t* Index = 0) { return string_to_float<long double>(s, Index); }
-	inline number<long double> stold(const std::wstring& s, size_t* Index = 0) { return wstring_to_float<long double>(s, Index); }
 }
 #endif
@@ -2,14 +2,23 @@
 #define __POSSIBLECHANGESTATUS_HPP__
 #include "Number.hpp"
 
-template<typename T, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
-class PossibleChangeStatus : public standard::number<T> {
+// 第２テンプレート引数 : 最大値・最小値の保持方法(standard::dynamic_bounds、standard::static_bounds、standard::shared_bounds)
+template<typename T, class Bounds = standard::dynamic_bounds<T>>
+class PossibleChangeStatus : public standard::number<T, Bounds> {
+private:
+	static constexpr standard::number<T, Bounds> FromSingleValue(const T Num) {
+		if constexpr (Bounds::is_dynamic) return standard::number<T, Bounds>(Num, Num, 0);
+		else return standard::number<T, Bounds>(Num);
+	}
 public:
-	PossibleChangeStatus() : standard::number<T>() {}
-	constexpr PossibleChangeStatus(const T Max)
-		: PossibleChangeStatus(Max, Max) {}
+	PossibleChangeStatus() : standard::number<T, Bounds>() { this->SetStatKind(Instrumentation::StatKind::Status); }
+	// 最大値・最小値を保持する場合 : 引数は最大値で、現在値も最大値になる
+	// 最大値・最小値が固定の場合　 : 引数は現在値
+	constexpr PossibleChangeStatus(const T Num)
+		: standard::number<T, Bounds>(FromSingleValue(Num)) { this->SetStatKind(Instrumentation::StatKind::Status); }
+	template<class B = Bounds, std::enable_if_t<B::is_dynamic, std::nullptr_t> = nullptr>
 	constexpr PossibleChangeStatus(const T Current, const T MaxStatus, const T MinStatus = 0)
-		: standard::number<T>(Current, MaxStatus, MinStatus) {}
+		: standard::number<T, Bounds>(Current, MaxStatus, MinStatus) { this->SetStatKind(Instrumentation::StatKind::Status); }
 	// 最小値であるかを判定する
 	bool IsMin() const noexcept { return this->GetMin() == this->Get(); }
 	// 最大値であるかを判定する
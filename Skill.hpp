@@ -1,26 +1,41 @@
 #ifndef __SKILL_HPP__
 #define __SKILL_HPP__
 #include "Element.hpp"
+#include <string>
+#include <string_view>
 
-struct SkillA {
-	std::string Name;			// 名前
-	int UseMP;					// 消費MP
-	int BasePower;				// 基本攻撃力
-	std::string Description;	// 説明
-	ElementInfo SkillElement;	// 属性(enum class値)
+// テンプレート引数：名前と説明の文字型
+template<typename CharT>
+struct BasicSkill {
+	std::basic_string<CharT> Name;			// 名前
+	int UseMP;								// 消費MP
+	int BasePower;							// 基本攻撃力
+	std::basic_string<CharT> Description;	// 説明
+	ElementInfo SkillElement;				// 属性(enum class値)
 };
 
-struct SkillW {
-	std::wstring Name;			// 名前
-	int UseMP;					// 消費MP
-	int BasePower;				// 基本攻撃力
-	std::wstring Description;	// 説明
-	ElementInfo SkillElement;	// 属性(enum class値)
+// 名前と説明をコピーせずに元のテキストを参照するスキル(MasterDataLoaderで読み込む時等に使用する)
+// 参照先のテキストが有効な間のみ使用できる。長く保持する場合はSkillTableに登録する
+// テンプレート引数：名前と説明の文字型
+template<typename CharT>
+struct BasicSkillView {
+	std::basic_string_view<CharT> Name;			// 名前
+	int UseMP;									// 消費MP
+	int BasePower;								// 基本攻撃力
+	std::basic_string_view<CharT> Description;	// 説明
+	ElementInfo SkillElement;					// 属性(enum class値)
 };
 
+typedef BasicSkill<char> SkillA;
+typedef BasicSkill<wchar_t> SkillW;
+typedef BasicSkillView<char> SkillViewA;
+typedef BasicSkillView<wchar_t> SkillViewW;
+
 #if defined(UNICODE)
 typedef SkillW Skill;
+typedef SkillViewW SkillView;
 #else
 typedef SkillA Skill;
+typedef SkillViewA SkillView;
 #endif
 #endif
@@ -0,0 +1,290 @@
+﻿#ifndef __SKILLTABLE_HPP__
+#define __SKILLTABLE_HPP__
+#include "Skill.hpp"
+#include "MemoryMappedFile.hpp"
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <unordered_map>
+#include <memory>
+#include <fstream>
+#include <utility>
+#include <iterator>
+#include <type_traits>
+
+// スキル表の中でスキルを識別する番号
+enum class SkillId : std::uint32_t { Invalid = 0xFFFFFFFF };
+
+// バイナリ中のstd::uint32_tの配列をSkillIdとして列挙する範囲
+class SkillIdRange {
+private:
+	const std::uint32_t* First;
+	const std::uint32_t* Last;
+public:
+	class Iterator {
+	private:
+		const std::uint32_t* Position;
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = SkillId;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const SkillId*;
+		using reference = SkillId;
+		explicit Iterator(const std::uint32_t* Position = nullptr) noexcept : Position(Position) {}
+		SkillId operator*() const noexcept { return static_cast<SkillId>(*this->Position); }
+		Iterator& operator++() noexcept {
+			++this->Position;
+			return *this;
+		}
+		Iterator operator++(int) noexcept {
+			const Iterator Result = *this;
+			++this->Position;
+			return Result;
+		}
+		bool operator==(const Iterator& r) const noexcept { return this->Position == r.Position; }
+		bool operator!=(const Iterator& r) const noexcept { return this->Position != r.Position; }
+	};
+	SkillIdRange(const std::uint32_t* First = nullptr, const std::uint32_t* Last = nullptr) noexcept : First(First), Last(Last) {}
+	Iterator begin() const noexcept { return Iterator(this->First); }
+	Iterator end() const noexcept { return Iterator(this->Last); }
+	size_t size() const noexcept { return static_cast<size_t>(this->Last - this->First); }
+	bool empty() const noexcept { return this->First == this->Last; }
+	SkillId operator[](const size_t Index) const noexcept { return static_cast<SkillId>(this->First[Index]); }
+};
+
+/*
+スキル表
+名前と説明を１つの文字列領域にまとめ、名前と属性から検索するための索引と共に１つの連続したバイナリとして保持する
+このバイナリはそのままファイルに保存でき、読み込み時はファイルをメモリにマップするだけで解析せずに使用できる
+
+バイナリの構成(全て実行環境のバイトオーダー)
+Header
+Record[SkillNum]
+std::uint32_t NameBucket[BucketNum]					名前のハッシュによるオープンアドレス法の索引(SkillId + 1、0は空き)
+std::uint32_t ElementOffset[ElementNum + 1]			属性毎のElementSkillの開始位置
+std::uint32_t ElementSkill[SkillNum]				属性順に並べたSkillId
+CharT String[StringLength]							名前と説明(同じ文字列は１つにまとめられる)
+*/
+template<typename CharT>
+class BasicSkillTable {
+public:
+	using SkillType = BasicSkill<CharT>;
+	using StringView = std::basic_string_view<CharT>;
+	static constexpr std::uint32_t FormatMagic = 0x42544B53; // "SKTB"
+	// 2 : 名前のハッシュで文字を符号なしとして扱うようにした(charが符号付きの環境では1と索引が異なる)
+	static constexpr std::uint32_t FormatVersion = 2;
+private:
+	struct Header {
+		std::uint32_t Magic, Version, CharSize, SkillNum, BucketNum, ElementNum, StringLength, Reserved;
+	};
+	struct Record {
+		std::uint32_t NameOffset, NameLength, DescriptionOffset, DescriptionLength;
+		std::int32_t UseMP, BasePower;
+		std::uint32_t Element;
+	};
+	std::shared_ptr<const void> Owner;
+	const Header* Head;
+	const Record* Records;
+	const std::uint32_t* NameBucket;
+	const std::uint32_t* ElementOffset;
+	const std::uint32_t* ElementSkill;
+	const CharT* String;
+	// FNV-1a。charが符号付きの環境でも保存したバイナリの索引が変わらないよう、文字は符号なしの値として扱う
+	static std::uint32_t Hash(const StringView Str) noexcept {
+		std::uint32_t Result = 2166136261u;
+		for (const CharT c : Str) {
+			Result ^= static_cast<std::uint32_t>(static_cast<std::make_unsigned_t<CharT>>(c));
+			Result *= 16777619u;
+		}
+		return Result;
+	}
+	// 各要素数はstd::uint32_tのため、size_tで計算する(読み込み時はFitsInで収まることを確認済み)
+	static constexpr size_t GetBinarySize(const Header& Head) noexcept {
+		return sizeof(Header) + sizeof(Record) * static_cast<size_t>(Head.SkillNum)
+			+ sizeof(std::uint32_t) * (static_cast<size_t>(Head.BucketNum) + static_cast<size_t>(Head.ElementNum) + 1 + static_cast<size_t>(Head.SkillNum))
+			+ sizeof(CharT) * static_cast<size_t>(Head.StringLength);
+	}
+	// 文字列領域の範囲内かを判定する
+	static constexpr bool IsInString(const Header& Head, const std::uint32_t Offset, const std::uint32_t Length) noexcept {
+		return Offset <= Head.StringLength && Length <= Head.StringLength - Offset;
+	}
+	// ヘッダーの要素数が示す各領域がバイナリに収まっているかを確認する
+	// 32bit環境でも桁あふれしないよう、合計せずに残りの大きさから順に差し引く
+	static bool FitsIn(const Header& Head, size_t Size) noexcept {
+		const auto Take = [&Size](const size_t Num, const size_t Unit) {
+			if (Num > Size / Unit) return false;
+			Size -= Num * Unit;
+			return true;
+		};
+		return Take(1, sizeof(Header)) && Take(Head.SkillNum, sizeof(Record)) && Take(Head.BucketNum, sizeof(std::uint32_t))
+			&& Take(Head.ElementNum, sizeof(std::uint32_t)) && Take(1, sizeof(std::uint32_t)) && Take(Head.SkillNum, sizeof(std::uint32_t))
+			&& Take(Head.StringLength, sizeof(CharT));
+	}
+	// 索引と文字列の位置が全てバイナリの範囲内を指しているかを確認する
+	// 読み込み後の検索・取得は範囲を確認しないため、ここでスキル数に比例する確認を１度だけ行う
+	void Validate() const {
+		const Header& Head = *this->Head;
+		for (std::uint32_t i = 0; i < Head.SkillNum; i++) {
+			const Record& r = this->Records[i];
+			if (!IsInString(Head, r.NameOffset, r.NameLength) || !IsInString(Head, r.DescriptionOffset, r.DescriptionLength) || r.Element >= Head.ElementNum)
+				throw std::runtime_error("invalid skill table record.");
+			if (this->ElementSkill[i] >= Head.SkillNum) throw std::runtime_error("invalid skill table element index.");
+		}
+		for (std::uint32_t i = 0; i < Head.BucketNum; i++) {
+			if (this->NameBucket[i] > Head.SkillNum) throw std::runtime_error("invalid skill table name index.");
+		}
+		if (this->ElementOffset[0] != 0 || this->ElementOffset[Head.ElementNum] != Head.SkillNum) throw std::runtime_error("invalid skill table element index.");
+		for (std::uint32_t i = 0; i < Head.ElementNum; i++) {
+			if (this->ElementOffset[i] > this->ElementOffset[i + 1]) throw std::runtime_error("invalid skill table element index.");
+		}
+	}
+	void Attach(std::shared_ptr<const void> Owner, const void* Data, const size_t Size) {
+		if (Size < sizeof(Header)) throw std::runtime_error("skill table is too small.");
+		if (reinterpret_cast<std::uintptr_t>(Data) % alignof(Header) != 0) throw std::runtime_error("skill table is not aligned.");
+		const Header* Head = static_cast<const Header*>(Data);
+		if (Head->Magic != FormatMagic || Head->Version != FormatVersion) throw std::runtime_error("invalid skill table format.");
+		if (Head->CharSize != sizeof(CharT)) throw std::runtime_error("skill table character size mismatch.");
+		// 名前の検索は空きバケットで止まるため、スキル数より多い２のべき乗でなければならない
+		if (Head->BucketNum == 0 || (Head->BucketNum & (Head->BucketNum - 1)) != 0 || Head->BucketNum <= Head->SkillNum)
+			throw std::runtime_error("invalid skill table bucket count.");
+		if (!FitsIn(*Head, Size)) throw std::runtime_error("skill table is truncated.");
+		this->Head = Head;
+		this->Records = reinterpret_cast<const Record*>(Head + 1);
+		this->NameBucket = reinterpret_cast<const std::uint32_t*>(this->Records + Head->SkillNum);
+		this->ElementOffset = this->NameBucket + Head->BucketNum;
+		this->ElementSkill = this->ElementOffset + Head->ElementNum + 1;
+		this->String = reinterpret_cast<const CharT*>(this->ElementSkill + Head->SkillNum);
+		this->Validate();
+		this->Owner = std::move(Owner);
+	}
+	const Record& GetRecord(const SkillId Id) const noexcept { return this->Records[static_cast<std::uint32_t>(Id)]; }
+	BasicSkillTable() = default;
+public:
+	// スキルのリストから表を作成する。名前と説明は表の文字列領域にまとめてコピーされる
+	// 引数：BasicSkillまたはBasicSkillView(読み込んだテキストを参照したまま、スキル毎の文字列を確保せずに登録できる)の配列
+	// 例外：名前が重複している場合、std::runtime_errorが投げられる
+	template<class Skill, std::enable_if_t<std::is_same<Skill, SkillType>::value || std::is_same<Skill, BasicSkillView<CharT>>::value, std::nullptr_t> = nullptr>
+	BasicSkillTable(const std::vector<Skill>& Skills) {
+		std::basic_string<CharT> StringArena;
+		// 作成中はSkillsの文字列が有効なため、キーは元の文字列を参照する
+		std::unordered_map<StringView, std::uint32_t> Interned;
+		const auto Intern = [&StringArena, &Interned](const StringView Str) {
+			const auto Result = Interned.emplace(Str, static_cast<std::uint32_t>(StringArena.size()));
+			if (Result.second) StringArena += Str;
+			return Result.first->second;
+		};
+		Header Head{};
+		Head.Magic = FormatMagic;
+		Head.Version = FormatVersion;
+		Head.CharSize = sizeof(CharT);
+		Head.SkillNum = static_cast<std::uint32_t>(Skills.size());
+		Head.BucketNum = 1;
+		while (Head.BucketNum < Head.SkillNum * 2) Head.BucketNum <<= 1;
+		for (const Skill& Src : Skills) Head.ElementNum = std::max(Head.ElementNum, static_cast<std::uint32_t>(Src.SkillElement) + 1);
+		std::vector<Record> Records(Skills.size());
+		std::vector<std::uint32_t> NameBucket(Head.BucketNum, 0);
+		std::vector<std::uint32_t> ElementOffset(Head.ElementNum + 1, 0);
+		for (std::uint32_t i = 0; i < Head.SkillNum; i++) {
+			const Skill& Src = Skills[i];
+			Records[i] = { Intern(Src.Name), static_cast<std::uint32_t>(Src.Name.size()), Intern(Src.Description), static_cast<std::uint32_t>(Src.Description.size()),
+				Src.UseMP, Src.BasePower, static_cast<std::uint32_t>(Src.SkillElement) };
+			for (std::uint32_t Bucket = Hash(Src.Name) & (Head.BucketNum - 1);; Bucket = (Bucket + 1) & (Head.BucketNum - 1)) {
+				if (NameBucket[Bucket] == 0) {
+					NameBucket[Bucket] = i + 1;
+					break;
+				}
+				if (Skills[NameBucket[Bucket] - 1].Name == Src.Name) throw std::runtime_error("skill name is duplicated.");
+			}
+			ElementOffset[Records[i].Element + 1]++;
+		}
+		for (std::uint32_t i = 0; i < Head.ElementNum; i++) ElementOffset[i + 1] += ElementOffset[i];
+		std::vector<std::uint32_t> ElementSkill(Head.SkillNum);
+		std::vector<std::uint32_t> Filled(ElementOffset.begin(), ElementOffset.end() - 1);
+		for (std::uint32_t i = 0; i < Head.SkillNum; i++) ElementSkill[Filled[Records[i].Element]++] = i;
+		Head.StringLength = static_cast<std::uint32_t>(StringArena.size());
+
+		const size_t Size = GetBinarySize(Head);
+		auto Buffer = std::make_shared<std::vector<std::uint32_t>>((Size + sizeof(std::uint32_t) - 1) / sizeof(std::uint32_t));
+		unsigned char* Out = reinterpret_cast<unsigned char*>(Buffer->data());
+		const auto Write = [&Out](const void* Src, const size_t Bytes) {
+			if (Bytes != 0) std::memcpy(Out, Src, Bytes);
+			Out += Bytes;
+		};
+		Write(&Head, sizeof(Header));
+		Write(Records.data(), sizeof(Record) * Records.size());
+		Write(NameBucket.data(), sizeof(std::uint32_t) * NameBucket.size());
+		Write(ElementOffset.data(), sizeof(std::uint32_t) * ElementOffset.size());
+		Write(ElementSkill.data(), sizeof(std::uint32_t) * ElementSkill.size());
+		Write(StringArena.data(), sizeof(CharT) * StringArena.size());
+		this->Attach(Buffer, Buffer->data(), Size);
+	}
+	// 既存のバイナリを参照する表を作成する。データはコピーされないため、表を使用している間は有効である必要がある
+	// 例外：形式が正しくない場合、std::runtime_errorが投げられる
+	static BasicSkillTable View(const void* Data, const size_t Size) {
+		BasicSkillTable Table;
+		Table.Attach(nullptr, Data, Size);
+		return Table;
+	}
+	// Saveで保存したファイルをメモリにマップして読み込む
+	// 例外：ファイルを開けない場合、形式が正しくない場合、std::runtime_errorが投げられる
+	static BasicSkillTable Load(const std::string& FilePath) {
+		const auto File = std::make_shared<const MemoryMappedFile>(FilePath);
+		BasicSkillTable Table;
+		Table.Attach(File, File->GetData(), File->GetSize());
+		return Table;
+	}
+	// 表をファイルに保存する
+	// 例外：ファイルに書き込めない場合、std::runtime_errorが投げられる
+	void Save(const std::string& FilePath) const {
+		std::ofstream ofs(FilePath, std::ios::binary | std::ios::trunc);
+		if (!ofs || !ofs.write(static_cast<const char*>(this->GetData()), static_cast<std::streamsize>(this->GetDataSize())))
+			throw std::runtime_error("failed to write " + FilePath);
+	}
+	// バイナリの先頭を取得する
+	const void* GetData() const noexcept { return this->Head; }
+	// バイナリのサイズを取得する
+	size_t GetDataSize() const noexcept { return GetBinarySize(*this->Head); }
+	// 登録されているスキル数を取得する
+	size_t Size() const noexcept { return this->Head->SkillNum; }
+	// 名前を取得する
+	StringView GetName(const SkillId Id) const noexcept { return StringView(this->String + this->GetRecord(Id).NameOffset, this->GetRecord(Id).NameLength); }
+	// 説明を取得する
+	StringView GetDescription(const SkillId Id) const noexcept { return StringView(this->String + this->GetRecord(Id).DescriptionOffset, this->GetRecord(Id).DescriptionLength); }
+	// 消費MPを取得する
+	int GetUseMP(const SkillId Id) const noexcept { return this->GetRecord(Id).UseMP; }
+	// 基本攻撃力を取得する
+	int GetBasePower(const SkillId Id) const noexcept { return this->GetRecord(Id).BasePower; }
+	// 属性を取得する
+	ElementInfo GetElement(const SkillId Id) const noexcept { return static_cast<ElementInfo>(this->GetRecord(Id).Element); }
+	// スキルをSkillA/SkillWとして取得する(名前と説明はコピーされる)
+	SkillType Get(const SkillId Id) const {
+		return SkillType{ std::basic_string<CharT>(this->GetName(Id)), this->GetUseMP(Id), this->GetBasePower(Id), std::basic_string<CharT>(this->GetDescription(Id)), this->GetElement(Id) };
+	}
+	// 名前からスキルを検索する
+	// 戻り値：見つからない場合はSkillId::Invalid
+	SkillId Find(const StringView Name) const noexcept {
+		const std::uint32_t Mask = this->Head->BucketNum - 1;
+		for (std::uint32_t Bucket = Hash(Name) & Mask;; Bucket = (Bucket + 1) & Mask) {
+			const std::uint32_t Entry = this->NameBucket[Bucket];
+			if (Entry == 0) return SkillId::Invalid;
+			if (this->GetName(static_cast<SkillId>(Entry - 1)) == Name) return static_cast<SkillId>(Entry - 1);
+		}
+	}
+	// 指定された属性のスキルを取得する
+	// 戻り値：SkillIdの範囲(バイナリ中の配列を参照する)
+	SkillIdRange FindByElement(const ElementInfo Element) const noexcept {
+		const size_t Index = static_cast<size_t>(Element);
+		if (Index >= this->Head->ElementNum) return SkillIdRange();
+		return SkillIdRange(this->ElementSkill + this->ElementOffset[Index], this->ElementSkill + this->ElementOffset[Index + 1]);
+	}
+};
+
+typedef BasicSkillTable<char> SkillTableA;
+typedef BasicSkillTable<wchar_t> SkillTableW;
+
+#if defined(UNICODE)
+typedef SkillTableW SkillTable;
+#else
+typedef SkillTableA SkillTable;
+#endif
+#endif
@@ -1,17 +1,22 @@
 #ifndef __SPEEDMANAGER_HPP__
 #define __SPEEDMANAGER_HPP__
 #include "UseDamageCalculationParameter.hpp"
+#include "CounterBasedRandom.hpp"
 #include <random>
 
 template<typename T, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
 class SpeedManager : public UseDamageCalculationParameter<T> {
 public:
-	SpeedManager() : UseDamageCalculationParameter<T>() {}
-	SpeedManager(const T DefaultNum) : UseDamageCalculationParameter<T>(DefaultNum) {}
-	SpeedManager(const T DefaultNum, const T Max, const T Min) : UseDamageCalculationParameter<T>(DefaultNum, Max, Min) {}
+	SpeedManager() : UseDamageCalculationParameter<T>() { this->SetStatKind(Instrumentation::StatKind::Speed); }
+	SpeedManager(const T DefaultNum) : UseDamageCalculationParameter<T>(DefaultNum) { this->SetStatKind(Instrumentation::StatKind::Speed); }
+	SpeedManager(const T DefaultNum, const T Max, const T Min) : UseDamageCalculationParameter<T>(DefaultNum, Max, Min) { this->SetStatKind(Instrumentation::StatKind::Speed); }
 	T GetParameterToCreateAttackTurn(std::mt19937& RandEngine, const T MaxAddPoint, const T MinAddPoint) const {
 		std::uniform_int_distribution<T> rand(MinAddPoint, MaxAddPoint);
 		return this->Get() + rand(RandEngine);
 	}
+	// カウンターベースの乱数を使用する。同じ乱数生成器・カウンター・ストリーム番号からは常に同じ値が得られる
+	T GetParameterToCreateAttackTurn(const CounterBasedRandom& RandEngine, const std::uint64_t Counter, const std::uint64_t Stream, const T MaxAddPoint, const T MinAddPoint) const noexcept {
+		return this->Get() + RandEngine.Generate<T>(Counter, Stream, MinAddPoint, MaxAddPoint);
+	}
 };
 #endif
@@ -0,0 +1,192 @@
+﻿#ifndef __TEXT_HPP__
+#define __TEXT_HPP__
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <system_error>
+#include <cstddef>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TEXT_SSE2
+#include <emmintrin.h>
+#endif
+
+/*
+文字型に依存しない文字列処理
+std::basic_string、std::basic_string_view、文字列リテラル等から文字型を取り出し、char/wchar_t等の処理を１つのテンプレートで扱う
+符号単位の大きさで符号化方式を決める(1バイト : UTF-8、2バイト : UTF-16、4バイト : UTF-32)
+*/
+namespace standard {
+	template<typename CharT>
+	struct is_char : std::integral_constant<bool, std::is_same<CharT, char>::value || std::is_same<CharT, wchar_t>::value
+		|| std::is_same<CharT, char16_t>::value || std::is_same<CharT, char32_t>::value> {};
+
+	namespace internal {
+		template<class Text, class = void>
+		struct text_traits {};
+		template<typename CharT, class Traits, class Allocator>
+		struct text_traits<std::basic_string<CharT, Traits, Allocator>, std::enable_if_t<is_char<CharT>::value>> { using char_type = CharT; };
+		template<typename CharT, class Traits>
+		struct text_traits<std::basic_string_view<CharT, Traits>, std::enable_if_t<is_char<CharT>::value>> { using char_type = CharT; };
+		template<typename CharT>
+		struct text_traits<const CharT*, std::enable_if_t<is_char<CharT>::value>> { using char_type = CharT; };
+		template<typename CharT>
+		struct text_traits<CharT*, std::enable_if_t<is_char<CharT>::value>> { using char_type = CharT; };
+	}
+	// 文字列の文字型。文字列でない型の場合は置き換えに失敗する(SFINAEで候補から外れる)
+	template<class Text>
+	using text_char_t = typename internal::text_traits<std::decay_t<Text>>::char_type;
+
+	// 文字列をコピーせずにstd::basic_string_viewとして参照する
+	template<class Text, class CharT = text_char_t<Text>>
+	constexpr std::basic_string_view<CharT> to_string_view(const Text& s) noexcept { return std::basic_string_view<CharT>(s); }
+
+	namespace internal {
+		// 先頭から続くASCII文字を変換し、変換した符号単位の数を返す。SSE2が使える場合は16バイト単位で処理する
+		template<typename From, typename To>
+		size_t copy_ascii(const From* Src, const size_t Length, To* Dest) noexcept {
+			size_t i = 0;
+#ifdef TEXT_SSE2
+			if constexpr (sizeof(From) == 1 && sizeof(To) != 1) {
+				const __m128i Zero = _mm_setzero_si128();
+				for (; i + 16 <= Length; i += 16) {
+					const __m128i Bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Src + i));
+					if (_mm_movemask_epi8(Bytes) != 0) break;
+					const __m128i Low = _mm_unpacklo_epi8(Bytes, Zero), High = _mm_unpackhi_epi8(Bytes, Zero);
+					if constexpr (sizeof(To) == 2) {
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(Dest + i), Low);
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(Dest + i + 8), High);
+					}
+					else {
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(Dest + i), _mm_unpacklo_epi16(Low, Zero));
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(Dest + i + 4), _mm_unpackhi_epi16(Low, Zero));
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(Dest + i + 8), _mm_unpacklo_epi16(High, Zero));
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(Dest + i + 12), _mm_unpackhi_epi16(High, Zero));
+					}
+				}
+			}
+			else if constexpr (sizeof(From) != 1 && sizeof(To) == 1) {
+				constexpr size_t Step = 16 / sizeof(From);
+				const __m128i NonAscii = sizeof(From) == 2 ? _mm_set1_epi16(static_cast<short>(0xFF80)) : _mm_set1_epi32(static_cast<int>(0xFFFFFF80));
+				for (; i + 16 <= Length; i += 16) {
+					__m128i Unit[4];
+					__m128i Any = _mm_setzero_si128();
+					for (size_t j = 0; j < 16 / Step; j++) {
+						Unit[j] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Src + i + j * Step));
+						Any = _mm_or_si128(Any, _mm_and_si128(Unit[j], NonAscii));
+					}
+					if (_mm_movemask_epi8(_mm_cmpeq_epi8(Any, _mm_setzero_si128())) != 0xFFFF) break;
+					// 全て0x80未満のため、符号付きの飽和でも値は変わらない
+					const __m128i Packed = sizeof(From) == 2 ? _mm_packus_epi16(Unit[0], Unit[1])
+						: _mm_packus_epi16(_mm_packs_epi32(Unit[0], Unit[1]), _mm_packs_epi32(Unit[2], Unit[3]));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(Dest + i), Packed);
+				}
+			}
+#endif
+			for (; i < Length && static_cast<std::make_unsigned_t<From>>(Src[i]) < 0x80; i++) Dest[i] = static_cast<To>(Src[i]);
+			return i;
+		}
+		// 符号位置を１つ読む。不正な並びの場合はfalseを返す
+		template<typename CharT>
+		bool decode(const CharT*& Src, const CharT* End, char32_t& CodePoint) noexcept {
+			using Unit = std::make_unsigned_t<CharT>;
+			const char32_t First = static_cast<Unit>(*Src++);
+			if constexpr (sizeof(CharT) == 1) {
+				if (First < 0x80) {
+					CodePoint = First;
+					return true;
+				}
+				const size_t Length = First >= 0xF0 ? 3 : First >= 0xE0 ? 2 : First >= 0xC2 ? 1 : 0;
+				if (Length == 0 || First > 0xF4 || static_cast<size_t>(End - Src) < Length) return false;
+				char32_t Result = First & (0x3F >> Length);
+				for (size_t i = 0; i < Length; i++) {
+					const char32_t Next = static_cast<Unit>(*Src++);
+					if ((Next & 0xC0) != 0x80) return false;
+					Result = (Result << 6) | (Next & 0x3F);
+				}
+				// 冗長な表現、サロゲート、範囲外を除く
+				constexpr char32_t MinCodePoint[] = { 0, 0x80, 0x800, 0x10000 };
+				if (Result < MinCodePoint[Length] || (Result >= 0xD800 && Result <= 0xDFFF) || Result > 0x10FFFF) return false;
+				CodePoint = Result;
+				return true;
+			}
+			else if constexpr (sizeof(CharT) == 2) {
+				if (First < 0xD800 || First > 0xDFFF) {
+					CodePoint = First;
+					return true;
+				}
+				if (First >= 0xDC00 || Src == End) return false;
+				const char32_t Second = static_cast<Unit>(*Src);
+				if (Second < 0xDC00 || Second > 0xDFFF) return false;
+				Src++;
+				CodePoint = 0x10000 + ((First - 0xD800) << 10) + (Second - 0xDC00);
+				return true;
+			}
+			else {
+				if ((First >= 0xD800 && First <= 0xDFFF) || First > 0x10FFFF) return false;
+				CodePoint = First;
+				return true;
+			}
+		}
+		// 符号位置を書き込み、書き込んだ符号単位の数を返す
+		template<typename CharT>
+		size_t encode(const char32_t CodePoint, CharT* Dest) noexcept {
+			if constexpr (sizeof(CharT) == 1) {
+				if (CodePoint < 0x80) {
+					Dest[0] = static_cast<CharT>(CodePoint);
+					return 1;
+				}
+				const size_t Length = CodePoint < 0x800 ? 2 : CodePoint < 0x10000 ? 3 : 4;
+				constexpr unsigned char Lead[] = { 0, 0, 0xC0, 0xE0, 0xF0 };
+				for (size_t i = Length - 1; i > 0; i--) Dest[i] = static_cast<CharT>(0x80 | ((CodePoint >> (6 * (Length - 1 - i))) & 0x3F));
+				Dest[0] = static_cast<CharT>(Lead[Length] | (CodePoint >> (6 * (Length - 1))));
+				return Length;
+			}
+			else if constexpr (sizeof(CharT) == 2) {
+				if (CodePoint < 0x10000) {
+					Dest[0] = static_cast<CharT>(CodePoint);
+					return 1;
+				}
+				Dest[0] = static_cast<CharT>(0xD800 + ((CodePoint - 0x10000) >> 10));
+				Dest[1] = static_cast<CharT>(0xDC00 + ((CodePoint - 0x10000) & 0x3FF));
+				return 2;
+			}
+			else {
+				Dest[0] = static_cast<CharT>(CodePoint);
+				return 1;
+			}
+		}
+	}
+
+	// 文字列の符号化方式を変換する(UTF-8、UTF-16、UTF-32の相互変換)
+	// ASCII文字が続く部分はSSE2で16文字ずつ変換するため、マスターデータのような大半がASCIIのテキストを読み込み時に一括で変換する用途に向く
+	// 第１引数：変換元
+	// 第２引数：変換結果の出力先(容量は再利用される)
+	// 戻り値　：成功した場合はstd::errc()、不正な並びが含まれる場合はstd::errc::illegal_byte_sequence(出力先は空になる)
+	template<class Text, typename To, class From = text_char_t<Text>>
+	std::errc transcode(const Text& Source, std::basic_string<To>& Result) {
+		static_assert(is_char<To>::value, "To must be a character type.");
+		const std::basic_string_view<From> s = to_string_view(Source);
+		// 変換先の符号単位の最大数(UTF-32→UTF-16はサロゲートペアで2、UTF-16→UTF-8は3、UTF-32→UTF-8は4)
+		constexpr size_t MaxUnit = sizeof(To) == 1 ? (sizeof(From) == 2 ? 3 : sizeof(From) == 4 ? 4 : 1) : sizeof(To) == 2 && sizeof(From) == 4 ? 2 : 1;
+		Result.resize(s.size() * MaxUnit);
+		const From* Src = s.data();
+		const From* const End = Src + s.size();
+		To* const Begin = &Result[0];
+		To* Dest = Begin;
+		while (Src != End) {
+			const size_t Ascii = internal::copy_ascii(Src, static_cast<size_t>(End - Src), Dest);
+			Src += Ascii;
+			Dest += Ascii;
+			if (Src == End) break;
+			char32_t CodePoint;
+			if (!internal::decode(Src, End, CodePoint)) {
+				Result.clear();
+				return std::errc::illegal_byte_sequence;
+			}
+			Dest += internal::encode(CodePoint, Dest);
+		}
+		Result.resize(static_cast<size_t>(Dest - Begin));
+		return std::errc();
+	}
+}
+#endif
@@ -0,0 +1,90 @@
+﻿#ifndef __TIMERWHEEL_HPP__
+#define __TIMERWHEEL_HPP__
+#include <vector>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+/*
+階層型タイマーホイール
+ターン数を単位として、指定したターンにPayloadを取り出す
+64スロット×4段で構成し、１段目は１ターン毎、２段目は64ターン毎…にスロットを割り当てる
+上の段のスロットは下の段が一周した時に下の段へ振り分け直すため、期限を迎える登録がないターンの処理はスロット１つの確認だけで済む
+*/
+template<class Payload>
+class TimerWheel {
+private:
+	static constexpr unsigned int SlotBit = 6;
+	static constexpr std::uint64_t SlotNum = 1ull << SlotBit;
+	static constexpr std::uint64_t SlotMask = SlotNum - 1;
+	static constexpr unsigned int LevelNum = 4;
+	struct Entry {
+		std::uint64_t ExpireTurn;
+		Payload Data;
+	};
+	std::array<std::array<std::vector<Entry>, SlotNum>, LevelNum> Wheel;
+	std::uint64_t CurrentTurn;
+	size_t Count;
+	// ExpireTurnは現在のターン以降であること(現在のターンの場合は振り分け直しの直後に取り出される)
+	void Insert(Entry&& e) {
+		const std::uint64_t Expire = e.ExpireTurn;
+		const std::uint64_t Delta = Expire - this->CurrentTurn;
+		for (unsigned int Level = 0; Level < LevelNum; Level++) {
+			if (Level + 1 == LevelNum || Delta < (1ull << (SlotBit * (Level + 1)))) {
+				// 最上段の範囲を超えるものは最上段の最も遠いスロットに置き、振り分け直す時に改めて位置を決める
+				const std::uint64_t Limit = this->CurrentTurn + (1ull << (SlotBit * LevelNum)) - 1;
+				const std::uint64_t Slot = ((Expire < Limit ? Expire : Limit) >> (SlotBit * Level)) & SlotMask;
+				this->Wheel[Level][Slot].push_back(std::move(e));
+				return;
+			}
+		}
+	}
+	void Cascade(const unsigned int Level) {
+		std::vector<Entry>& Slot = this->Wheel[Level][(this->CurrentTurn >> (SlotBit * Level)) & SlotMask];
+		std::vector<Entry> Moving;
+		Moving.swap(Slot);
+		for (Entry& e : Moving) this->Insert(std::move(e));
+		// 使い終わった領域をスロットに戻し、次回の確保を避ける
+		if (Slot.empty()) {
+			Moving.clear();
+			Slot.swap(Moving);
+		}
+	}
+public:
+	// 引数：開始時のターン
+	TimerWheel(const std::uint64_t StartTurn = 0) : CurrentTurn(StartTurn), Count(0) {}
+	// 現在のターンを取得する
+	std::uint64_t GetCurrentTurn() const noexcept { return this->CurrentTurn; }
+	// 登録されている数を取得する
+	size_t Size() const noexcept { return this->Count; }
+	// 第１引数：取り出すターン。現在のターン以前を指定した場合は次のターンに取り出す
+	// 第２引数：取り出すデータ
+	void Schedule(const std::uint64_t ExpireTurn, Payload Data) {
+		// 既に期限を過ぎているものは次のターンに取り出す
+		this->Insert(Entry{ ExpireTurn > this->CurrentTurn ? ExpireTurn : this->CurrentTurn + 1, std::move(Data) });
+		this->Count++;
+	}
+	// ターンを１つ進め、期限を迎えたデータを引数にしてCallbackを呼び出す
+	template<class Function>
+	void Advance(Function&& Callback) {
+		this->CurrentTurn++;
+		for (unsigned int Level = 1; Level < LevelNum && ((this->CurrentTurn >> (SlotBit * (Level - 1))) & SlotMask) == 0; Level++) this->Cascade(Level);
+		std::vector<Entry>& Slot = this->Wheel[0][this->CurrentTurn & SlotMask];
+		if (Slot.empty()) return;
+		std::vector<Entry> Expired;
+		Expired.swap(Slot);
+		this->Count -= Expired.size();
+		for (Entry& e : Expired) Callback(e.Data);
+		if (Slot.empty()) {
+			Expired.clear();
+			Slot.swap(Expired);
+		}
+	}
+	// 指定されたターンまで進める
+	template<class Function>
+	void AdvanceTo(const std::uint64_t Turn, Function&& Callback) {
+		while (this->CurrentTurn < Turn) this->Advance(Callback);
+	}
+};
+#endif
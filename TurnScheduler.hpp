@@ -0,0 +1,160 @@
+﻿#ifndef __TURNSCHEDULER_HPP__
+#define __TURNSCHEDULER_HPP__
+#include "SpeedManager.hpp"
+#include <vector>
+#include <limits>
+#include <stdexcept>
+
+// 行動順を管理するクラス
+// ラウンド開始時に素早さ＋乱数で行動順の基準値を決め、インデックス付きヒープから素早い順に１体ずつ取り出す
+// 乱数はカウンターベースのため、同じシードであればラウンド中の素早さの変化も含めて行動順を再現できる
+template<typename T, std::enable_if_t<std::is_integral<T>::value, std::nullptr_t> = nullptr>
+class TurnScheduler {
+private:
+	static constexpr size_t NotInRound = std::numeric_limits<size_t>::max();
+	std::vector<SpeedManager<T>> Speed;
+	std::vector<T> TurnPoint;
+	std::vector<size_t> Heap;
+	std::vector<size_t> HeapPosition;
+	std::vector<bool> Removed;
+	CounterBasedRandom RandEngine;
+	std::uint64_t Round;
+	T MaxAddPoint, MinAddPoint;
+	// 基準値が大きい方を先に、同じ場合は番号が小さい方を先にする
+	bool IsPrior(const size_t Left, const size_t Right) const noexcept {
+		return this->TurnPoint[Left] != this->TurnPoint[Right] ? this->TurnPoint[Left] > this->TurnPoint[Right] : Left < Right;
+	}
+	void Place(const size_t Position, const size_t Id) noexcept {
+		this->Heap[Position] = Id;
+		this->HeapPosition[Id] = Position;
+	}
+	void SiftUp(size_t Position) noexcept {
+		const size_t Id = this->Heap[Position];
+		while (Position > 0) {
+			const size_t Parent = (Position - 1) / 2;
+			if (!this->IsPrior(Id, this->Heap[Parent])) break;
+			this->Place(Position, this->Heap[Parent]);
+			Position = Parent;
+		}
+		this->Place(Position, Id);
+	}
+	void SiftDown(size_t Position) noexcept {
+		const size_t Id = this->Heap[Position];
+		const size_t Num = this->Heap.size();
+		while (true) {
+			size_t Child = Position * 2 + 1;
+			if (Child >= Num) break;
+			if (Child + 1 < Num && this->IsPrior(this->Heap[Child + 1], this->Heap[Child])) Child++;
+			if (!this->IsPrior(this->Heap[Child], Id)) break;
+			this->Place(Position, this->Heap[Child]);
+			Position = Child;
+		}
+		this->Place(Position, Id);
+	}
+	void EraseFromHeap(const size_t Id) noexcept {
+		const size_t Position = this->HeapPosition[Id];
+		const size_t Last = this->Heap.back();
+		this->Heap.pop_back();
+		this->HeapPosition[Id] = NotInRound;
+		if (Last == Id) return;
+		this->Place(Position, Last);
+		this->SiftUp(Position);
+		this->SiftDown(this->HeapPosition[Last]);
+	}
+	void UpdateTurnPoint(const size_t Id) noexcept {
+		this->TurnPoint[Id] = this->Speed[Id].GetParameterToCreateAttackTurn(this->RandEngine, this->Round, Id, this->MaxAddPoint, this->MinAddPoint);
+		if (this->HeapPosition[Id] == NotInRound) return;
+		this->SiftUp(this->HeapPosition[Id]);
+		this->SiftDown(this->HeapPosition[Id]);
+	}
+public:
+	// 第１引数：乱数のシード
+	// 第２引数：素早さに加算する乱数の最大値
+	// 第３引数：素早さに加算する乱数の最小値
+	TurnScheduler(const std::uint64_t Seed, const T MaxAddPoint, const T MinAddPoint)
+		: RandEngine(Seed), Round(0), MaxAddPoint(MaxAddPoint), MinAddPoint(MinAddPoint) {
+		if (MaxAddPoint < MinAddPoint) throw std::runtime_error("MaxAddPoint must be larger than MinAddPoint.");
+	}
+	// 全キャラクターを削除し、シードと乱数の範囲を変えてラウンド0からやり直す。確保済みの領域は再利用する
+	// 例外：MaxAddPointがMinAddPointより小さい場合、std::runtime_errorが投げられる
+	void Clear(const std::uint64_t Seed, const T MaxAddPoint, const T MinAddPoint) {
+		if (MaxAddPoint < MinAddPoint) throw std::runtime_error("MaxAddPoint must be larger than MinAddPoint.");
+		this->Speed.clear();
+		this->TurnPoint.clear();
+		this->Heap.clear();
+		this->HeapPosition.clear();
+		this->Removed.clear();
+		this->RandEngine = CounterBasedRandom(Seed);
+		this->Round = 0;
+		this->MaxAddPoint = MaxAddPoint;
+		this->MinAddPoint = MinAddPoint;
+	}
+	// キャラクターを追加する。追加されたキャラクターは次のラウンドから行動する
+	// 戻り値：追加したキャラクターの番号
+	size_t Add(const SpeedManager<T>& Speed) {
+		this->Speed.push_back(Speed);
+		this->TurnPoint.push_back(T());
+		this->HeapPosition.push_back(NotInRound);
+		this->Removed.push_back(false);
+		return this->Speed.size() - 1;
+	}
+	// 登録されているキャラクター数を取得する
+	size_t Size() const noexcept { return this->Speed.size(); }
+	// 現在のラウンド数を取得する
+	std::uint64_t GetRound() const noexcept { return this->Round; }
+	// 素早さを取得する
+	const SpeedManager<T>& GetSpeed(const size_t Id) const { return this->Speed[Id]; }
+	// 現在のラウンドの行動順の基準値を取得する
+	T GetTurnPoint(const size_t Id) const { return this->TurnPoint[Id]; }
+	// 現在のラウンドでまだ行動していないキャラクター数を取得する
+	size_t GetRemainingNum() const noexcept { return this->Heap.size(); }
+	// 行動対象から外されているかを取得する
+	bool IsRemoved(const size_t Id) const { return this->Removed[Id]; }
+	// 次のラウンドを開始する。前のラウンドで行動していないキャラクターも含め、外されていない全キャラクターの行動順を決め直す
+	void StartRound() {
+		this->Round++;
+		this->Heap.clear();
+		for (size_t i = 0; i < this->Speed.size(); i++) {
+			this->TurnPoint[i] = this->Speed[i].GetParameterToCreateAttackTurn(this->RandEngine, this->Round, i, this->MaxAddPoint, this->MinAddPoint);
+			if (this->Removed[i]) continue;
+			this->Heap.push_back(i);
+			this->HeapPosition[i] = this->Heap.size() - 1;
+		}
+		for (size_t i = this->Heap.size() / 2; i > 0; i--) this->SiftDown(i - 1);
+	}
+	// 次に行動するキャラクターを取り出す
+	// 戻り値：キャラクターの番号。現在のラウンドで全員が行動済みの場合はstd::numeric_limits<size_t>::max()
+	size_t Next() noexcept {
+		if (this->Heap.empty()) return NotInRound;
+		const size_t Id = this->Heap.front();
+		this->EraseFromHeap(Id);
+		return Id;
+	}
+	// 行動対象から外す(戦闘不能等)。現在のラウンドだけでなく、Reviveを呼ぶまで以降のラウンドでも行動しない
+	void Remove(const size_t Id) {
+		this->Removed[Id] = true;
+		if (this->HeapPosition[Id] != NotInRound) this->EraseFromHeap(Id);
+	}
+	// Removeで外したキャラクターを行動対象に戻す(蘇生等)。戻したキャラクターは次のラウンドから行動する
+	void Revive(const size_t Id) { this->Removed[Id] = false; }
+	// 素早さの上昇。まだ行動していない場合は現在のラウンドの行動順にも反映される
+	// 戻り値：実際に上がった値
+	T PowerUp(const size_t Id, const T AddNum) {
+		const T Result = this->Speed[Id].PowerUp(AddNum);
+		this->UpdateTurnPoint(Id);
+		return Result;
+	}
+	// 素早さの下降。まだ行動していない場合は現在のラウンドの行動順にも反映される
+	// 戻り値：実際に下がった値
+	T PowerDown(const size_t Id, const T SubtractNum) {
+		const T Result = this->Speed[Id].PowerDown(SubtractNum);
+		this->UpdateTurnPoint(Id);
+		return Result;
+	}
+	// 上下した素早さを元に戻す
+	void Reset(const size_t Id) {
+		this->Speed[Id].Reset();
+		this->UpdateTurnPoint(Id);
+	}
+};
+#endif
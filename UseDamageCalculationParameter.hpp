@@ -2,16 +2,18 @@
 #define __USEDAMAGECALCULATIONPARAMETER_HPP__
 #include "Number.hpp"
 
-template<typename T, std::enable_if_t<std::is_arithmetic<T>::value, std::nullptr_t> = nullptr>
-class UseDamageCalculationParameter : public standard::number<T> {
+// 第２テンプレート引数 : 最大値・最小値の保持方法(standard::dynamic_bounds、standard::static_bounds、standard::shared_bounds)
+template<typename T, class Bounds = standard::dynamic_bounds<T>>
+class UseDamageCalculationParameter : public standard::number<T, Bounds> {
 private:
 	T DefaultParameter;
 public:
-	UseDamageCalculationParameter() : standard::number<T>() {}
+	UseDamageCalculationParameter() : standard::number<T, Bounds>() { this->SetStatKind(Instrumentation::StatKind::Parameter); }
 	constexpr UseDamageCalculationParameter(const T DefaultNum)
-		: standard::number<T>(DefaultNum), DefaultParameter(this->cmp(DefaultNum)) {}
+		: standard::number<T, Bounds>(DefaultNum), DefaultParameter(this->cmp(DefaultNum)) { this->SetStatKind(Instrumentation::StatKind::Parameter); }
+	template<class B = Bounds, std::enable_if_t<B::is_dynamic, std::nullptr_t> = nullptr>
 	constexpr UseDamageCalculationParameter(const T DefaultNum, const T Max, const T Min)
-		: standard::number<T>(DefaultNum, Max, Min), DefaultParameter(this->cmp(DefaultNum)) {}
+		: standard::number<T, Bounds>(DefaultNum, Max, Min), DefaultParameter(this->cmp(DefaultNum)) { this->SetStatKind(Instrumentation::StatKind::Parameter); }
 	// 上下したパラメーターを元に戻す
 	void Reset() { this->ChangeCurrentNumToReserevedNum(this->DefaultParameter); }
 	// パラメーターの上昇
@@ -30,6 +32,8 @@ public:
 		this->operator-=(SubtractNum);
 		return Before - this->Get();
 	}
+	// 元のパラメーターを取得する
+	T GetDefault() const noexcept { return this->DefaultParameter; }
 	// 現在値を取得する
 	T operator * () const noexcept { return this->Get(); }
 };
@@ -0,0 +1,543 @@
+#include "Number.hpp"
+#include "Element.hpp"
+#include "LevelManager.hpp"
+#include "SpeedManager.hpp"
+#include "DamageCalculation.hpp"
+#include "AtomicPossibleChangeStatus.hpp"
+#include "CharacterDatabase.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#ifdef _MSC_VER
+#include <malloc.h>
+#endif
+
+/*
+外部のライブラリを使用しないベンチマーク
+各ベンチマークの１回当たりの時間(ns/op)とメモリ確保回数(allocations/op)をJSONで出力し、
+基準値のファイルが指定された場合は比較して、許容範囲を超えて遅くなったものやメモリ確保が増えたものがあれば失敗で終了する
+
+引数
+--output <file>     結果のJSONの出力先(省略した場合は標準出力)
+--baseline <file>   比較する基準値のJSON(以前の--outputの出力)
+--tolerance <ratio> 基準値より遅くなることを許容する割合(既定値は1.0。ctestの比較もこの値を使う)
+--filter <text>     名前にtextを含むベンチマークのみ実行する
+--min-time <sec>    １回の計測の最短時間(既定値は0.1)
+*/
+
+// メモリ確保回数の計測
+namespace {
+	std::atomic<std::uint64_t> AllocationNum(0);
+	void* Allocate(const std::size_t Size) {
+		AllocationNum.fetch_add(1, std::memory_order_relaxed);
+		if (void* p = std::malloc(Size == 0 ? 1 : Size)) return p;
+		throw std::bad_alloc();
+	}
+	void* AllocateAligned(const std::size_t Size, const std::align_val_t Alignment) {
+		AllocationNum.fetch_add(1, std::memory_order_relaxed);
+		const std::size_t Align = std::max(static_cast<std::size_t>(Alignment), sizeof(void*));
+#ifdef _MSC_VER
+		if (void* p = _aligned_malloc(Size == 0 ? 1 : Size, Align)) return p;
+#else
+		void* p = nullptr;
+		if (posix_memalign(&p, Align, Size == 0 ? 1 : Size) == 0) return p;
+#endif
+		throw std::bad_alloc();
+	}
+	void DeallocateAligned(void* p) noexcept {
+#ifdef _MSC_VER
+		_aligned_free(p);
+#else
+		std::free(p);
+#endif
+	}
+}
+void* operator new(const std::size_t Size) { return Allocate(Size); }
+void* operator new(const std::size_t Size, const std::align_val_t Alignment) { return AllocateAligned(Size, Alignment); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { DeallocateAligned(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { DeallocateAligned(p); }
+
+namespace {
+	// 計算結果が最適化で消されないようにする
+	template<typename T>
+	inline void DoNotOptimize(const T& Value) {
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "r,m"(Value) : "memory");
+#else
+		static volatile char Sink;
+		Sink = *reinterpret_cast<const volatile char*>(&Value);
+#endif
+	}
+
+	struct BenchmarkResult {
+		std::string Name;
+		double NanosecondPerOperation;
+		double AllocationPerOperation;
+		std::uint64_t Iteration;
+	};
+
+	// Functionは引数の回数だけ処理を行い、実際に行った操作の数を返す
+	using BenchmarkFunction = std::function<std::uint64_t(std::uint64_t)>;
+
+	struct Benchmark {
+		std::string Name;
+		BenchmarkFunction Function;
+	};
+
+	// 最短時間を超えるまで回数を増やして計測し、３回計測した中で最も速いものを結果とする
+	BenchmarkResult Measure(const Benchmark& Target, const double MinTime) {
+		using Clock = std::chrono::steady_clock;
+		std::uint64_t Iteration = 1;
+		Target.Function(Iteration);
+		while (true) {
+			const Clock::time_point Begin = Clock::now();
+			Target.Function(Iteration);
+			const double Elapsed = std::chrono::duration<double>(Clock::now() - Begin).count();
+			if (Elapsed >= MinTime / 4) {
+				Iteration = static_cast<std::uint64_t>(static_cast<double>(Iteration) * MinTime / Elapsed) + 1;
+				break;
+			}
+			Iteration *= 4;
+		}
+		BenchmarkResult Result{ Target.Name, 0.0, 0.0, 0 };
+		for (int Repeat = 0; Repeat < 3; Repeat++) {
+			const std::uint64_t AllocationBefore = AllocationNum.load(std::memory_order_relaxed);
+			const Clock::time_point Begin = Clock::now();
+			const std::uint64_t Operation = Target.Function(Iteration);
+			const double Elapsed = std::chrono::duration<double, std::nano>(Clock::now() - Begin).count();
+			const double Allocation = static_cast<double>(AllocationNum.load(std::memory_order_relaxed) - AllocationBefore);
+			const double NanosecondPerOperation = Elapsed / static_cast<double>(Operation);
+			if (Repeat == 0 || NanosecondPerOperation < Result.NanosecondPerOperation) {
+				Result.NanosecondPerOperation = NanosecondPerOperation;
+				Result.AllocationPerOperation = Allocation / static_cast<double>(Operation);
+				Result.Iteration = Operation;
+			}
+		}
+		return Result;
+	}
+
+	// ２つのスレッド数で同じ処理を行う場合のスレッド数
+	unsigned int GetContentionThreadNum() { return std::max(2u, std::min(4u, std::thread::hardware_concurrency())); }
+
+	// 整列済みのレコードと追記されたレコードを持つデータベースを一時ファイルに作成する(終了時に削除する)
+	// 同時に実行された他のプロセスとファイルが衝突しないように、ファイル名には乱数と時刻を含める
+	class BenchmarkDatabase {
+	private:
+		std::string FilePath;
+		std::unique_ptr<CharacterDatabase> Database;
+		static std::string CreateFilePath() {
+			std::random_device Seed;
+			const unsigned long long Unique = (static_cast<unsigned long long>(Seed()) << 32) ^ static_cast<unsigned long long>(std::chrono::steady_clock::now().time_since_epoch().count());
+			char FileName[64];
+			std::snprintf(FileName, sizeof(FileName), "RPGLibraryBenchmark-%016llx.chdb", Unique);
+			return (std::filesystem::temp_directory_path() / FileName).string();
+		}
+	public:
+		static constexpr std::uint64_t SortedNum = 65536, AppendedNum = 4096;
+		BenchmarkDatabase() : FilePath(CreateFilePath()) {
+			this->Database = std::make_unique<CharacterDatabase>(CharacterDatabase::Create(this->FilePath));
+			std::vector<CharacterRecord> Records;
+			for (std::uint64_t Id = 0; Id < SortedNum; Id++) {
+				Records.push_back(CharacterRecord::Create(Id * 2, PossibleChangeStatus<int>(500), PossibleChangeStatus<int>(100), UseDamageCalculationParameter<int>(120, 999, 0),
+					UseDamageCalculationParameter<int>(80, 999, 0), SpeedManager<int>(60, 999, 0), Id));
+			}
+			this->Database->Append(Records);
+			this->Database->Compact();
+			Records.resize(AppendedNum);
+			for (std::uint64_t i = 0; i < AppendedNum; i++) Records[i].Id = i * 32 + 1;
+			this->Database->Append(Records);
+		}
+		~BenchmarkDatabase() {
+			this->Database.reset();
+			std::error_code Error;
+			std::filesystem::remove(this->FilePath, Error);
+		}
+		const CharacterDatabase& Get() const noexcept { return *this->Database; }
+	};
+	const CharacterDatabase& GetBenchmarkDatabase() {
+		static const BenchmarkDatabase Instance;
+		return Instance.Get();
+	}
+
+	std::vector<Benchmark> CreateBenchmarkList() {
+		std::vector<Benchmark> List;
+
+		// standard::number
+		List.push_back({ "Number.RawIntAdd", [](const std::uint64_t Num) {
+			int Value = 0;
+			for (std::uint64_t i = 0; i < Num; i++) {
+				Value = std::min(std::max(Value + static_cast<int>(i & 15) - 7, 0), 9999);
+				DoNotOptimize(Value);
+			}
+			return Num;
+		} });
+		List.push_back({ "Number.Add", [](const std::uint64_t Num) {
+			standard::number<int> Value(0, 9999, 0);
+			for (std::uint64_t i = 0; i < Num; i++) {
+				Value += static_cast<int>(i & 15) - 7;
+				DoNotOptimize(Value);
+			}
+			return Num;
+		} });
+		List.push_back({ "Number.BinaryOperator", [](const std::uint64_t Num) {
+			standard::number<unsigned int> Value(5000u, 9999u, 0u);
+			const standard::number<unsigned int> Step(3u);
+			for (std::uint64_t i = 0; i < Num; i++) {
+				Value = (i & 1) != 0 ? Value + Step : Value - Step;
+				DoNotOptimize(Value);
+			}
+			return Num;
+		} });
+		List.push_back({ "Number.SaturatingMul", [](const std::uint64_t Num) {
+			long long Value = 1;
+			for (std::uint64_t i = 0; i < Num; i++) {
+				Value = standard::saturating_mul(Value | 1, static_cast<long long>(i & 7) - 3);
+				DoNotOptimize(Value);
+			}
+			return Num;
+		} });
+		List.push_back({ "Number.SaturatingSubSpan", [](const std::uint64_t Num) {
+			constexpr size_t Size = 4096;
+			std::vector<unsigned int> Hp(Size, 5000u), Damage(Size);
+			for (size_t i = 0; i < Size; i++) Damage[i] = static_cast<unsigned int>(i % 97);
+			const std::uint64_t Repeat = Num / Size + 1;
+			for (std::uint64_t r = 0; r < Repeat; r++) {
+				standard::saturating_sub(Hp.data(), Damage.data(), Size, 9999u, 0u);
+				DoNotOptimize(Hp[r % Size]);
+			}
+			return Repeat * Size;
+		} });
+
+		// Element
+		List.push_back({ "Element.Advantage", [](const std::uint64_t Num) {
+			const Element Defence[] = { Element(ElementInfo::Fire), Element(ElementInfo::Ice), Element(ElementInfo::Shine), Element(ElementInfo::Normal) };
+			float Total = 0.0f;
+			for (std::uint64_t i = 0; i < Num; i++) {
+				Total += Defence[i & 3].Advantage(static_cast<ElementInfo>(i & 7));
+				DoNotOptimize(Total);
+			}
+			return Num;
+		} });
+		// 相性表を導入する前の判定方法(呼び出し毎に弱点・強みの属性のリストを作成して線形探索する)との比較
+		List.push_back({ "Element.AdvantageLegacy", [](const std::uint64_t Num) {
+			const ElementInfo Defence[] = { ElementInfo::Fire, ElementInfo::Ice, ElementInfo::Shine, ElementInfo::Normal };
+			const auto Advantage = [](const ElementInfo DefenceElement, const ElementInfo AttackElement) {
+				if (DefenceElement == ElementInfo::Normal || AttackElement == ElementInfo::Normal) return 1.0f;
+				std::vector<ElementInfo> Weak, Beauty;
+				switch (DefenceElement) {
+					case ElementInfo::Fire:
+						Weak = { ElementInfo::Ice, ElementInfo::Earth };
+						Beauty = { ElementInfo::Fire, ElementInfo::Thunder, ElementInfo::Wind };
+						break;
+					case ElementInfo::Ice:
+						Weak = { ElementInfo::Thunder, ElementInfo::Wind };
+						Beauty = { ElementInfo::Fire, ElementInfo::Ice, ElementInfo::Earth };
+						break;
+					default:
+						Weak = { ElementInfo::Dark };
+						Beauty = { ElementInfo::Shine };
+						break;
+				}
+				const auto Contains = [AttackElement](const std::vector<ElementInfo>& List) { return std::any_of(List.begin(), List.end(), [AttackElement](const ElementInfo Elem) { return Elem == AttackElement; }); };
+				return Contains(Weak) ? 2.0f : Contains(Beauty) ? 0.5f : 1.0f;
+			};
+			float Total = 0.0f;
+			for (std::uint64_t i = 0; i < Num; i++) {
+				Total += Advantage(Defence[i & 3], static_cast<ElementInfo>(i & 7));
+				DoNotOptimize(Total);
+			}
+			return Num;
+		} });
+		List.push_back({ "Element.AdvantageWithMagnification", [](const std::uint64_t Num) {
+			const Element Defence(ElementInfo::Thunder);
+			float Total = 0.0f;
+			for (std::uint64_t i = 0; i < Num; i++) {
+				Total += Defence.Advantage(static_cast<ElementInfo>(i & 7), 0.25f, 3.0f);
+				DoNotOptimize(Total);
+			}
+			return Num;
+		} });
+
+		// LevelManager
+		List.push_back({ "LevelManager.AddExp", [](const std::uint64_t Num) {
+			std::vector<size_t> BorderPoint;
+			for (size_t Level = 2; Level <= 99; Level++) BorderPoint.push_back(Level * Level * Level * 1000);
+			const LevelCurve Curve(BorderPoint);
+			LevelManager Manager(Curve);
+			for (std::uint64_t i = 0; i < Num; i++) {
+				// 最大レベルに達したら最初から上げ直す
+				if (Manager.GetExpPointNeededToRaiseNextLevel() == 0) Manager = LevelManager(Curve);
+				DoNotOptimize(Manager.AddExp(1000 + (i & 1023)));
+			}
+			return Num;
+		} });
+
+		// SpeedManager
+		List.push_back({ "SpeedManager.GetParameterToCreateAttackTurn/mt19937", [](const std::uint64_t Num) {
+			const SpeedManager<int> Speed(100, 999, 0);
+			std::mt19937 RandEngine(1);
+			for (std::uint64_t i = 0; i < Num; i++) DoNotOptimize(Speed.GetParameterToCreateAttackTurn(RandEngine, 20, 0));
+			return Num;
+		} });
+		List.push_back({ "SpeedManager.GetParameterToCreateAttackTurn/CounterBasedRandom", [](const std::uint64_t Num) {
+			const SpeedManager<int> Speed(100, 999, 0);
+			const CounterBasedRandom RandEngine(1);
+			for (std::uint64_t i = 0; i < Num; i++) DoNotOptimize(Speed.GetParameterToCreateAttackTurn(RandEngine, i, 0, 20, 0));
+			return Num;
+		} });
+
+		// 数値の変換
+		static const char* const IntegerText[] = { "0", "42", "-1234", "999999", "2147483647", "-77", "31415", "8" };
+		static const char* const FloatText[] = { "0.5", "1.25", "-3.75", "100", "2.0e3", "0.001", "6.5", "-0.125" };
+		List.push_back({ "Parse.Integer", [](const std::uint64_t Num) {
+			std::string_view Text[8];
+			for (size_t i = 0; i < 8; i++) Text[i] = IntegerText[i];
+			for (std::uint64_t i = 0; i < Num; i++) {
+				int Value = 0;
+				DoNotOptimize(standard::parse(Text[i & 7], Value));
+				DoNotOptimize(Value);
+			}
+			return Num;
+		} });
+		List.push_back({ "Parse.Float", [](const std::uint64_t Num) {
+			std::string_view Text[8];
+			for (size_t i = 0; i < 8; i++) Text[i] = FloatText[i];
+			for (std::uint64_t i = 0; i < Num; i++) {
+				double Value = 0.0;
+				DoNotOptimize(standard::parse(Text[i & 7], Value));
+				DoNotOptimize(Value);
+			}
+			return Num;
+		} });
+		List.push_back({ "Parse.WideInteger", [](const std::uint64_t Num) {
+			const std::wstring_view Text[] = { L"0", L"42", L"-1234", L"999999", L"2147483647", L"-77", L"31415", L"8" };
+			for (std::uint64_t i = 0; i < Num; i++) {
+				int Value = 0;
+				DoNotOptimize(standard::parse(Text[i & 7], Value));
+				DoNotOptimize(Value);
+			}
+			return Num;
+		} });
+		List.push_back({ "Parse.LegacyStoi", [](const std::uint64_t Num) {
+			std::string Text[8];
+			for (size_t i = 0; i < 8; i++) Text[i] = IntegerText[i];
+			for (std::uint64_t i = 0; i < Num; i++) DoNotOptimize(standard::stoi(Text[i & 7]).Get());
+			return Num;
+		} });
+
+		// マスターデータのようなASCII中心のUTF-8テキストをUTF-16に変換する(１バイト当たり)
+		List.push_back({ "Text.TranscodeUtf8ToUtf16", [](const std::uint64_t Num) {
+			std::string Source;
+			while (Source.size() < 4096) Source += u8"Fire,4,30,炎で攻撃する,fire\nBlizzard,6,45,Attack with ice,ice\n";
+			std::u16string Result;
+			const std::uint64_t Repeat = Num / Source.size() + 1;
+			for (std::uint64_t r = 0; r < Repeat; r++) {
+				DoNotOptimize(standard::transcode(Source, Result));
+				DoNotOptimize(Result[r % Result.size()]);
+			}
+			return Repeat * Source.size();
+		} });
+
+		// ダメージ計算(１要素当たり)
+		const DamageCalculation::SimdLevel Supported = DamageCalculation::GetSupportedSimdLevel();
+		const char* const SimdName[] = { "Scalar", "SSE2", "AVX2" };
+		for (int Level = 0; Level <= static_cast<int>(Supported); Level++) {
+			List.push_back({ std::string("DamageCalculation.CalcDamage/") + SimdName[Level], [Level](const std::uint64_t Num) {
+				constexpr size_t Size = 4096;
+				std::vector<int> Attack(Size), BasePower(Size), Defence(Size), Damage(Size);
+				std::vector<float> Magnification(Size);
+				for (size_t i = 0; i < Size; i++) {
+					Attack[i] = static_cast<int>(100 + i % 900);
+					BasePower[i] = static_cast<int>(i % 200);
+					Defence[i] = static_cast<int>(50 + i % 700);
+					Magnification[i] = i % 3 == 0 ? 2.0f : i % 3 == 1 ? 0.5f : 1.0f;
+				}
+				const std::uint64_t Repeat = Num / Size + 1;
+				for (std::uint64_t r = 0; r < Repeat; r++) {
+					DamageCalculation::CalcDamage(Attack.data(), BasePower.data(), Defence.data(), Magnification.data(), Damage.data(), Size, static_cast<DamageCalculation::SimdLevel>(Level));
+					DoNotOptimize(Damage[r % Size]);
+				}
+				return Repeat * Size;
+			} });
+		}
+
+		// 複数のスレッドから同じＨＰを減算する(１回の減算当たり)
+		List.push_back({ "AtomicPossibleChangeStatus.SubtractContended", [](const std::uint64_t Num) {
+			const unsigned int ThreadNum = GetContentionThreadNum();
+			const std::uint64_t PerThread = Num / ThreadNum + 1;
+			AtomicPossibleChangeStatus<long long> HP(1LL << 60);
+			std::vector<std::thread> Threads;
+			for (unsigned int t = 0; t < ThreadNum; t++) {
+				Threads.emplace_back([&HP, PerThread] {
+					for (std::uint64_t i = 0; i < PerThread; i++) DoNotOptimize(HP.Subtract(1));
+				});
+			}
+			for (std::thread& t : Threads) t.join();
+			return PerThread * ThreadNum;
+		} });
+		List.push_back({ "AtomicPossibleChangeStatus.MutexSubtractContended", [](const std::uint64_t Num) {
+			const unsigned int ThreadNum = GetContentionThreadNum();
+			const std::uint64_t PerThread = Num / ThreadNum + 1;
+			PossibleChangeStatus<long long> HP(1LL << 60);
+			std::mutex Mutex;
+			std::vector<std::thread> Threads;
+			for (unsigned int t = 0; t < ThreadNum; t++) {
+				Threads.emplace_back([&HP, &Mutex, PerThread] {
+					for (std::uint64_t i = 0; i < PerThread; i++) {
+						std::lock_guard<std::mutex> Lock(Mutex);
+						const long long Before = *HP;
+						HP -= 1;
+						DoNotOptimize(Before - *HP);
+					}
+				});
+			}
+			for (std::thread& t : Threads) t.join();
+			return PerThread * ThreadNum;
+		} });
+
+		// マップしたデータベースからキャラクターを検索し、ＨＰを組み立てる(１回の検索当たり)
+		List.push_back({ "CharacterDatabase.Find", [](const std::uint64_t Num) {
+			const CharacterDatabase& Database = GetBenchmarkDatabase();
+			const std::uint64_t IdNum = BenchmarkDatabase::SortedNum * 2;
+			std::uint64_t Id = 0;
+			for (std::uint64_t i = 0; i < Num; i++) {
+				Id = (Id + 40503) % IdNum;
+				const CharacterView View = Database.Find(Id);
+				DoNotOptimize(View ? View.GetHP().Get() : 0);
+			}
+			return Num;
+		} });
+		return List;
+	}
+
+	std::string EscapeJson(const std::string& Text) {
+		std::string Result;
+		for (const char c : Text) {
+			if (c == '"' || c == '\\') Result += '\\';
+			Result += c;
+		}
+		return Result;
+	}
+
+	void WriteJson(std::ostream& Stream, const std::vector<BenchmarkResult>& Results) {
+		Stream << "{\n\t\"benchmarks\": [\n";
+		for (size_t i = 0; i < Results.size(); i++) {
+			char Line[512];
+			std::snprintf(Line, sizeof(Line), "\t\t{ \"name\": \"%s\", \"ns_per_op\": %.4f, \"allocations_per_op\": %.4f, \"iterations\": %llu }%s\n",
+				EscapeJson(Results[i].Name).c_str(), Results[i].NanosecondPerOperation, Results[i].AllocationPerOperation,
+				static_cast<unsigned long long>(Results[i].Iteration), i + 1 < Results.size() ? "," : "");
+			Stream << Line;
+		}
+		Stream << "\t]\n}\n";
+	}
+
+	// WriteJsonで出力した形式のみを読む
+	bool FindNumber(const std::string& Object, const char* Key, double& Result) {
+		const size_t Position = Object.find(std::string("\"") + Key + "\"");
+		if (Position == std::string::npos) return false;
+		const size_t Colon = Object.find(':', Position);
+		if (Colon == std::string::npos) return false;
+		Result = std::strtod(Object.c_str() + Colon + 1, nullptr);
+		return true;
+	}
+	bool ReadBaseline(const std::string& FilePath, std::vector<BenchmarkResult>& Results) {
+		std::ifstream ifs(FilePath);
+		if (!ifs) return false;
+		std::stringstream Buffer;
+		Buffer << ifs.rdbuf();
+		const std::string Text = Buffer.str();
+		for (size_t Begin = Text.find('{', Text.find('[')); Begin != std::string::npos; Begin = Text.find('{', Begin + 1)) {
+			const size_t End = Text.find('}', Begin);
+			if (End == std::string::npos) return false;
+			const std::string Object = Text.substr(Begin, End - Begin);
+			const size_t NameKey = Object.find("\"name\"");
+			if (NameKey == std::string::npos) return false;
+			const size_t NameBegin = Object.find('"', Object.find(':', NameKey)) + 1;
+			const size_t NameEnd = Object.find('"', NameBegin);
+			BenchmarkResult Result{ Object.substr(NameBegin, NameEnd - NameBegin), 0.0, 0.0, 0 };
+			if (!FindNumber(Object, "ns_per_op", Result.NanosecondPerOperation) || !FindNumber(Object, "allocations_per_op", Result.AllocationPerOperation)) return false;
+			Results.push_back(Result);
+		}
+		return true;
+	}
+
+	// 戻り値：基準値より悪化したベンチマークの数
+	size_t CompareWithBaseline(const std::vector<BenchmarkResult>& Results, const std::vector<BenchmarkResult>& Baseline, const double Tolerance) {
+		size_t RegressionNum = 0;
+		for (const BenchmarkResult& Result : Results) {
+			const auto Base = std::find_if(Baseline.begin(), Baseline.end(), [&Result](const BenchmarkResult& b) { return b.Name == Result.Name; });
+			if (Base == Baseline.end()) {
+				std::cerr << "[ NEW  ] " << Result.Name << " (no baseline)" << std::endl;
+				continue;
+			}
+			const bool Slower = Result.NanosecondPerOperation > Base->NanosecondPerOperation * (1.0 + Tolerance);
+			const bool MoreAllocation = Result.AllocationPerOperation > Base->AllocationPerOperation + 0.001;
+			std::cerr << (Slower || MoreAllocation ? "[REGRESS] " : "[  OK  ] ") << Result.Name << ": "
+				<< Result.NanosecondPerOperation << " ns/op (baseline " << Base->NanosecondPerOperation << "), "
+				<< Result.AllocationPerOperation << " allocations/op (baseline " << Base->AllocationPerOperation << ")" << std::endl;
+			if (Slower || MoreAllocation) RegressionNum++;
+		}
+		return RegressionNum;
+	}
+}
+
+int main(int argc, char* argv[]) {
+	std::string OutputPath, BaselinePath, Filter;
+	double Tolerance = 1.0, MinTime = 0.1;
+	for (int i = 1; i < argc; i++) {
+		const std::string Option = argv[i];
+		if (i + 1 >= argc) {
+			std::cerr << "missing value for " << Option << std::endl;
+			return 2;
+		}
+		const char* Value = argv[++i];
+		if (Option == "--output") OutputPath = Value;
+		else if (Option == "--baseline") BaselinePath = Value;
+		else if (Option == "--tolerance") Tolerance = std::atof(Value);
+		else if (Option == "--filter") Filter = Value;
+		else if (Option == "--min-time") MinTime = std::atof(Value);
+		else {
+			std::cerr << "unknown option " << Option << std::endl;
+			return 2;
+		}
+	}
+	std::vector<BenchmarkResult> Baseline;
+	if (!BaselinePath.empty() && !ReadBaseline(BaselinePath, Baseline)) {
+		std::cerr << "failed to read baseline " << BaselinePath << std::endl;
+		return 2;
+	}
+	std::vector<BenchmarkResult> Results;
+	for (const Benchmark& Target : CreateBenchmarkList()) {
+		if (!Filter.empty() && Target.Name.find(Filter) == std::string::npos) continue;
+		Results.push_back(Measure(Target, MinTime));
+	}
+	if (OutputPath.empty()) WriteJson(std::cout, Results);
+	else {
+		std::ofstream ofs(OutputPath);
+		WriteJson(ofs, Results);
+		if (!ofs) {
+			std::cerr << "failed to write " << OutputPath << std::endl;
+			return 2;
+		}
+	}
+	if (BaselinePath.empty()) return 0;
+	const size_t RegressionNum = CompareWithBaseline(Results, Baseline, Tolerance);
+	if (RegressionNum != 0) std::cerr << RegressionNum << " benchmarks regressed." << std::endl;
+	return RegressionNum == 0 ? 0 : 1;
+}
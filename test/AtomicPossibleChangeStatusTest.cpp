@@ -0,0 +1,64 @@
+#include "UnitTest.hpp"
+#include "AtomicPossibleChangeStatus.hpp"
+#include <thread>
+#include <vector>
+#include <atomic>
+
+TEST_CASE(AtomicPossibleChangeStatus, SingleThread) {
+	AtomicPossibleChangeStatus<int> HP(50, 100, 0);
+	CHECK_EQUAL(50, HP.Add(80));
+	CHECK(HP.IsMax());
+	bool ReachedMin = false;
+	CHECK_EQUAL(100, HP.Subtract(150, &ReachedMin));
+	CHECK(ReachedMin);
+	CHECK_EQUAL(0, HP.Subtract(10, &ReachedMin));
+	CHECK(!ReachedMin);
+	HP.Store(500);
+	CHECK_EQUAL(100, *HP);
+	CHECK_EQUAL(100, HP.Load().GetMax());
+	CHECK_THROWS(AtomicPossibleChangeStatus<int>(0, 0, 10));
+}
+
+// 複数のスレッドから同時に減算しても、減算された合計は現在値を超えず、最小値になったことを検知するのは１回のみ
+TEST_CASE(AtomicPossibleChangeStatus, Stress) {
+	constexpr int MaxHP = 100000;
+	constexpr unsigned int ThreadNum = 8;
+	constexpr int HitPerThread = 20000;
+	for (int Repeat = 0; Repeat < 5; Repeat++) {
+		AtomicPossibleChangeStatus<int> HP(MaxHP);
+		std::atomic<int> Applied(0), Death(0);
+		std::vector<std::thread> Threads;
+		for (unsigned int i = 0; i < ThreadNum; i++) {
+			Threads.emplace_back([&HP, &Applied, &Death] {
+				for (int Hit = 0; Hit < HitPerThread; Hit++) {
+					bool ReachedMin = false;
+					Applied.fetch_add(HP.Subtract(1, &ReachedMin), std::memory_order_relaxed);
+					if (ReachedMin) Death.fetch_add(1, std::memory_order_relaxed);
+				}
+			});
+		}
+		for (std::thread& t : Threads) t.join();
+		CHECK_EQUAL(MaxHP, Applied.load());
+		CHECK_EQUAL(1, Death.load());
+		CHECK(HP.IsMin());
+	}
+}
+
+// 回復と減算が混在しても範囲外の値にならず、実際に加減算された値の合計が現在値と一致する
+TEST_CASE(AtomicPossibleChangeStatus, MixedStress) {
+	AtomicPossibleChangeStatus<int> HP(500, 1000, 0);
+	std::atomic<long long> Total(0);
+	std::vector<std::thread> Threads;
+	for (unsigned int i = 0; i < 4; i++) {
+		Threads.emplace_back([&HP, &Total, i] {
+			for (int j = 0; j < 20000; j++) {
+				if ((i + j) % 2 == 0) Total.fetch_add(HP.Add(7), std::memory_order_relaxed);
+				else Total.fetch_sub(HP.Subtract(5), std::memory_order_relaxed);
+				const int Current = HP.Get();
+				if (Current < 0 || Current > 1000) Total.store(-1000000);
+			}
+		});
+	}
+	for (std::thread& t : Threads) t.join();
+	CHECK_EQUAL(500 + Total.load(), static_cast<long long>(HP.Get()));
+}
@@ -0,0 +1,52 @@
+#include "UnitTest.hpp"
+#include "BattleSimulator.hpp"
+
+namespace {
+	SimulationUnit CreateUnit(const int HP, const int Attack, const int Speed, const ElementInfo Elem, const ElementInfo SkillElement) {
+		return SimulationUnit{ PossibleChangeStatus<int>(HP), UseDamageCalculationParameter<int>(Attack, 9999, 0), UseDamageCalculationParameter<int>(40, 9999, 0),
+			SpeedManager<int>(Speed, 9999, 0), Elem, 30, SkillElement };
+	}
+	BattleSimulator CreateSimulator() {
+		return BattleSimulator(
+			{ CreateUnit(400, 90, 50, ElementInfo::Fire, ElementInfo::Ice), CreateUnit(300, 110, 70, ElementInfo::Wind, ElementInfo::Thunder) },
+			{ CreateUnit(500, 80, 60, ElementInfo::Ice, ElementInfo::Fire), CreateUnit(250, 120, 40, ElementInfo::Earth, ElementInfo::Earth), CreateUnit(200, 70, 90, ElementInfo::Dark, ElementInfo::Dark) },
+			50, 20, 0);
+	}
+}
+
+// 同じシードであればスレッド数に関係なく結果が一致する
+TEST_CASE(BattleSimulator, ReproducibleAcrossThreadNum) {
+	const BattleSimulator Simulator = CreateSimulator();
+	const SimulationResult Single = Simulator.Run(3000, 77, 1);
+	CHECK_EQUAL(3000u, Single.TeamAWin + Single.TeamBWin + Single.Draw);
+	std::uint64_t Decided = 0;
+	for (const std::uint64_t Count : Single.RoundHistogram) Decided += Count;
+	CHECK_EQUAL(Single.TeamAWin + Single.TeamBWin, Decided);
+	for (const unsigned int ThreadNum : { 2u, 3u, 8u }) {
+		const SimulationResult Multi = Simulator.Run(3000, 77, ThreadNum);
+		CHECK_EQUAL(Single.TeamAWin, Multi.TeamAWin);
+		CHECK_EQUAL(Single.TeamBWin, Multi.TeamBWin);
+		CHECK_EQUAL(Single.Draw, Multi.Draw);
+		CHECK(Single.RoundHistogram == Multi.RoundHistogram);
+	}
+	const SimulationResult Other = Simulator.Run(3000, 78, 1);
+	CHECK(Single.RoundHistogram != Other.RoundHistogram);
+}
+
+// 最初からＨＰが最小値のキャラクターは生存数に含めない
+TEST_CASE(BattleSimulator, PreDeadUnit) {
+	const BattleSimulator Simulator({ CreateUnit(400, 200, 50, ElementInfo::Normal, ElementInfo::Normal) },
+		{ CreateUnit(100, 10, 10, ElementInfo::Normal, ElementInfo::Normal), CreateUnit(0, 10, 10, ElementInfo::Normal, ElementInfo::Normal) }, 20);
+	const SimulationResult Result = Simulator.Run(100, 1, 2);
+	CHECK_EQUAL(100u, Result.TeamAWin);
+	const BattleSimulator AllDead({ CreateUnit(100, 10, 10, ElementInfo::Normal, ElementInfo::Normal) }, { CreateUnit(0, 10, 10, ElementInfo::Normal, ElementInfo::Normal) });
+	BattleSimulator::Workspace Work;
+	unsigned int Winner = 2;
+	CHECK_EQUAL(0u, AllDead.Simulate(CounterBasedRandom(1), Work, Winner));
+	CHECK_EQUAL(0u, Winner);
+}
+
+TEST_CASE(BattleSimulator, InvalidArgument) {
+	CHECK_THROWS(BattleSimulator({}, { CreateUnit(100, 10, 10, ElementInfo::Normal, ElementInfo::Normal) }));
+	CHECK_THROWS(BattleSimulator({ CreateUnit(100, 10, 10, ElementInfo::Normal, ElementInfo::Normal) }, { CreateUnit(100, 10, 10, ElementInfo::Normal, ElementInfo::Normal) }, 10, 0, 5));
+}
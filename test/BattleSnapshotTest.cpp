@@ -0,0 +1,69 @@
+#include "UnitTest.hpp"
+#include "BattleSnapshot.hpp"
+#include "PossibleChangeStatus.hpp"
+#include "LevelManager.hpp"
+#include "CharacterRoster.hpp"
+#include <vector>
+
+TEST_CASE(BattleSnapshot, CaptureAndRestore) {
+	PossibleChangeStatus<int> HP(100);
+	LevelManager Level(LevelCurve({ 10, 30, 60 }));
+	std::vector<int> Buffer(8, 0);
+	BattleSnapshot Snapshot(4);
+	Snapshot.Register(HP);
+	Snapshot.Register(Level);
+	Snapshot.Register(Buffer);
+	for (std::uint64_t Frame = 0; Frame < 6; Frame++) {
+		Snapshot.Capture(Frame);
+		HP -= 10;
+		Level.AddExp(10);
+		Buffer[Frame] = static_cast<int>(Frame);
+	}
+	// 保存しておけるのは最新の４フレームのみ
+	CHECK(!Snapshot.IsCaptured(1));
+	CHECK(Snapshot.IsCaptured(2));
+	CHECK(Snapshot.Restore(3));
+	CHECK_EQUAL(70, *HP);
+	CHECK_EQUAL(30u, Level.GetCurrentExp());
+	CHECK_EQUAL(3u, Level.GetCurrentLevel());
+	CHECK_EQUAL(2, Buffer[2]);
+	CHECK_EQUAL(0, Buffer[3]);
+	// 巻き戻したフレームより後のフレームは破棄される
+	CHECK(!Snapshot.IsCaptured(4));
+	CHECK_THROWS(Snapshot.Register(HP));
+}
+
+TEST_CASE(BattleSnapshot, Delta) {
+	CharacterRoster<int> Roster;
+	for (int i = 0; i < 100; i++) {
+		Roster.Add(PossibleChangeStatus<int>(500), PossibleChangeStatus<int>(50),
+			UseDamageCalculationParameter<int>(60, 999, 0), UseDamageCalculationParameter<int>(40, 999, 0), SpeedManager<int>(30, 999, 0));
+	}
+	BattleSnapshot Snapshot(8);
+	Snapshot.Register(Roster);
+	Snapshot.Capture(0);
+	std::vector<int> Damage(100, 0);
+	Damage[10] = 300;
+	Damage[90] = 1000;
+	Roster.ApplyDamage(Damage.data());
+	Snapshot.Capture(1);
+	std::vector<unsigned char> Delta;
+	Snapshot.EncodeDelta(0, 1, Delta);
+	CHECK(Delta.size() < 32);
+	CHECK(Snapshot.Restore(0));
+	CHECK_EQUAL(500, Roster.Get(RosterStatus::HP, 90));
+	CHECK(Snapshot.RestoreFromDelta(0, Delta));
+	CHECK_EQUAL(200, Roster.Get(RosterStatus::HP, 10));
+	CHECK_EQUAL(0, Roster.Get(RosterStatus::HP, 90));
+	CHECK(!Snapshot.RestoreFromDelta(0, std::vector<unsigned char>{ 0xFF }));
+	// 加算すると桁あふれする長さ(Same=1、Diff=2^64-1)や、状態の大きさを超える位置を持つ不正な差分
+	std::vector<unsigned char> Malformed{ 0x01 };
+	for (int i = 0; i < 9; i++) Malformed.push_back(0xFF);
+	Malformed.push_back(0x01);
+	Malformed.push_back(0xAA);
+	CHECK(!Snapshot.RestoreFromDelta(0, Malformed));
+	CHECK(!Snapshot.RestoreFromDelta(0, std::vector<unsigned char>{ 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01, 0x01, 0xAA }));
+	CHECK(!Snapshot.RestoreFromDelta(0, std::vector<unsigned char>{ 0x00, 0x05, 0xAA }));
+	CHECK_EQUAL(200, Roster.Get(RosterStatus::HP, 10));
+	CHECK_THROWS(Snapshot.EncodeDelta(0, 5, Delta));
+}
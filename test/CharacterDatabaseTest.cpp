@@ -0,0 +1,138 @@
+#include "UnitTest.hpp"
+#include "CharacterDatabase.hpp"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+	std::string GetDatabasePath() { return (std::filesystem::temp_directory_path() / "RPGLibraryCharacterDatabaseTest.chdb").string(); }
+	CharacterRecord MakeCharacter(const std::uint64_t Id, const int HP, const std::vector<SkillId>& Skills = {}) {
+		return CharacterRecord::Create(Id, PossibleChangeStatus<int>(HP, 999, 0), PossibleChangeStatus<int>(30, 50, 0),
+			UseDamageCalculationParameter<int>(120, 999, 0), UseDamageCalculationParameter<int>(80, 999, 0), SpeedManager<int>(60, 255, 1), 35, 2, Skills);
+	}
+}
+
+TEST_CASE(CharacterDatabase, AppendAndFind) {
+	const std::string Path = GetDatabasePath();
+	{
+		CharacterDatabase Database = CharacterDatabase::Create(Path);
+		CHECK_EQUAL(0u, Database.Size());
+		CHECK(!Database.Find(1));
+		Database.Append(MakeCharacter(10, 300, { static_cast<SkillId>(3), static_cast<SkillId>(7) }));
+		Database.Append(std::vector<CharacterRecord>{ MakeCharacter(20, 400), MakeCharacter(30, 500) });
+		CHECK_EQUAL(3u, Database.Size());
+		const CharacterView View = Database.Find(10);
+		CHECK(static_cast<bool>(View));
+		CHECK_EQUAL(300, *View.GetHP());
+		CHECK_EQUAL(999, View.GetHP().GetMax());
+		CHECK_EQUAL(30, *View.GetMP());
+		CHECK_EQUAL(120, *View.GetAttack());
+		CHECK_EQUAL(60, *View.GetSpeed());
+		CHECK_EQUAL(2u, View.GetCurveId());
+		CHECK_EQUAL(3u, View.GetLevelManager(LevelCurve({ 10, 30, 60 })).GetCurrentLevel());
+		const auto Skills = View.GetSkills();
+		CHECK_EQUAL(2u, Skills.size());
+		CHECK_EQUAL(static_cast<SkillId>(3), *Skills.begin());
+		CHECK_EQUAL(static_cast<SkillId>(7), Skills[1]);
+		// 上書きと削除は追記で行う
+		Database.Append(MakeCharacter(20, 1));
+		CHECK(Database.Remove(30));
+		CHECK(!Database.Remove(30));
+		CHECK_EQUAL(2u, Database.Size());
+		CHECK_EQUAL(5u, Database.GetRecordNum());
+		CHECK_EQUAL(1, *Database.Find(20).GetHP());
+		CHECK(!Database.Contains(30));
+	}
+	// 開き直しても追記した内容が反映される
+	CharacterDatabase Database(Path);
+	CHECK_EQUAL(2u, Database.Size());
+	CHECK_EQUAL(1, *Database.Find(20).GetHP());
+	CHECK(!Database.Contains(30));
+	std::filesystem::remove(Path);
+}
+
+TEST_CASE(CharacterDatabase, Compact) {
+	const std::string Path = GetDatabasePath();
+	{
+		CharacterDatabase Database = CharacterDatabase::Create(Path);
+		std::vector<CharacterRecord> Records;
+		for (std::uint64_t Id = 1000; Id > 0; Id--) Records.push_back(MakeCharacter(Id, static_cast<int>(Id % 999)));
+		Database.Append(Records);
+		for (std::uint64_t Id = 1; Id <= 1000; Id += 2) Database.Remove(Id);
+		Database.Append(MakeCharacter(2, 777));
+		CHECK_EQUAL(500u, Database.Size());
+		Database.Compact();
+		CHECK_EQUAL(500u, Database.Size());
+		CHECK_EQUAL(500u, Database.GetRecordNum());
+		CHECK_EQUAL(0u, Database.GetAppendedNum());
+		CHECK_EQUAL(777, *Database.Find(2).GetHP());
+		CHECK(!Database.Contains(1));
+		// 整列済みの部分と追記された部分の両方から検索する
+		Database.Append(MakeCharacter(3, 33));
+		CHECK(Database.Remove(4));
+		CHECK_EQUAL(500u, Database.Size());
+		size_t Num = 0;
+		std::uint64_t IdSum = 0;
+		Database.ForEach([&Num, &IdSum](const CharacterView& View) {
+			Num++;
+			IdSum += View.GetId();
+		});
+		CHECK_EQUAL(500u, Num);
+		CHECK_EQUAL(250500u - 4u + 3u, IdSum);
+	}
+	CharacterDatabase Database(Path);
+	CHECK_EQUAL(500u, Database.Size());
+	CHECK_EQUAL(2u, Database.GetAppendedNum());
+	CHECK_EQUAL(33, *Database.Find(3).GetHP());
+	CHECK_EQUAL(6, *Database.Find(6).GetHP());
+	CHECK(!Database.Contains(4));
+	std::filesystem::remove(Path);
+}
+
+// １件ずつの追記は確保済みの領域に書き込み、足りなくなった時のみ拡張する
+TEST_CASE(CharacterDatabase, AppendOneByOne) {
+	const std::string Path = GetDatabasePath();
+	{
+		CharacterDatabase Database = CharacterDatabase::Create(Path);
+		for (std::uint64_t Id = 0; Id < 3000; Id++) Database.Append(MakeCharacter(Id, static_cast<int>(Id % 999)));
+		for (std::uint64_t Id = 0; Id < 3000; Id += 3) CHECK(Database.Remove(Id));
+		CHECK_EQUAL(2000u, Database.Size());
+		CHECK_EQUAL(4000u, Database.GetRecordNum());
+		CHECK_EQUAL(998, *Database.Find(2996).GetHP());
+	}
+	CharacterDatabase Database(Path);
+	CHECK_EQUAL(2000u, Database.Size());
+	CHECK_EQUAL(4000u, Database.GetRecordNum());
+	CHECK(!Database.Contains(2997));
+	CHECK_EQUAL(1, *Database.Find(2998).GetHP());
+	std::filesystem::remove(Path);
+}
+
+TEST_CASE(CharacterDatabase, InvalidFile) {
+	const std::string Path = GetDatabasePath();
+	CHECK_THROWS(CharacterDatabase{ Path + ".missing" });
+	{
+		std::ofstream ofs(Path, std::ios::binary | std::ios::trunc);
+		ofs << "not a character database file";
+	}
+	CHECK_THROWS(CharacterDatabase{ Path });
+	{
+		CharacterDatabase Database = CharacterDatabase::Create(Path);
+		Database.Append(MakeCharacter(1, 10));
+	}
+	// レコードが欠けている
+	std::filesystem::resize_file(Path, 32 + 100);
+	CHECK_THROWS(CharacterDatabase{ Path });
+	// オフセットの計算が桁あふれするレコード数
+	{
+		std::fstream fs(Path, std::ios::binary | std::ios::in | std::ios::out);
+		const std::uint64_t RecordNum = 0x8000000000000001ull;
+		fs.seekp(16);
+		fs.write(reinterpret_cast<const char*>(&RecordNum), sizeof(RecordNum));
+	}
+	CHECK_THROWS(CharacterDatabase{ Path });
+	std::vector<SkillId> TooMany(CharacterRecord::MaxSkillNum + 1, static_cast<SkillId>(0));
+	CHECK_THROWS(MakeCharacter(1, 10, TooMany));
+	std::filesystem::remove(Path);
+}
@@ -0,0 +1,50 @@
+#include "UnitTest.hpp"
+#include "CharacterRoster.hpp"
+#include <vector>
+
+namespace {
+	CharacterRoster<int> CreateRoster() {
+		CharacterRoster<int> Roster(3);
+		for (int i = 0; i < 3; i++) {
+			Roster.Add(PossibleChangeStatus<int>(100 * (i + 1)), PossibleChangeStatus<int>(50),
+				UseDamageCalculationParameter<int>(60, 999, 0), UseDamageCalculationParameter<int>(40, 999, 0), SpeedManager<int>(30 + i, 999, 0));
+		}
+		return Roster;
+	}
+}
+
+TEST_CASE(CharacterRoster, DamageAndHeal) {
+	CharacterRoster<int> Roster = CreateRoster();
+	CHECK_EQUAL(3u, Roster.Size());
+	const int Damage[] = { 150, 50, 300 };
+	Roster.ApplyDamage(Damage);
+	CHECK_EQUAL(0, Roster.Get(RosterStatus::HP, 0));
+	CHECK_EQUAL(150, Roster.Get(RosterStatus::HP, 1));
+	CHECK_EQUAL(0, Roster.Get(RosterStatus::HP, 2));
+	std::vector<unsigned char> Mask;
+	Roster.IsMin(RosterStatus::HP, Mask);
+	CHECK((Mask == std::vector<unsigned char>{ 1, 0, 1 }));
+	Roster.AddAll(RosterStatus::HP, 120);
+	CHECK_EQUAL(100, Roster.Get(RosterStatus::HP, 0));
+	CHECK_EQUAL(200, Roster.Get(RosterStatus::HP, 1));
+	Roster.HealAll();
+	Roster.IsMax(RosterStatus::HP, Mask);
+	CHECK((Mask == std::vector<unsigned char>{ 1, 1, 1 }));
+}
+
+TEST_CASE(CharacterRoster, ParameterReset) {
+	CharacterRoster<int> Roster = CreateRoster();
+	const int Buff[] = { 10, 2000, -100 };
+	Roster.Add(RosterStatus::Attack, Buff);
+	CHECK_EQUAL(70, Roster.Get(RosterStatus::Attack, 0));
+	CHECK_EQUAL(999, Roster.Get(RosterStatus::Attack, 1));
+	CHECK_EQUAL(0, Roster.Get(RosterStatus::Attack, 2));
+	Roster.Add(RosterStatus::Speed, Buff);
+	Roster.Reset(RosterStatus::Attack);
+	CHECK_EQUAL(60, Roster.Get(RosterStatus::Attack, 1));
+	CHECK_EQUAL(40, Roster.Get(RosterStatus::Speed, 0));
+	Roster.Reset();
+	CHECK_EQUAL(30, Roster.Get(RosterStatus::Speed, 0));
+	CHECK_THROWS(Roster.Reset(RosterStatus::HP));
+	CHECK_EQUAL(200, Roster.GetStatus(RosterStatus::HP, 1).GetMax());
+}
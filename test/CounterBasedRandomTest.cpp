@@ -0,0 +1,35 @@
+#include "UnitTest.hpp"
+#include "CounterBasedRandom.hpp"
+#include "SpeedManager.hpp"
+
+TEST_CASE(CounterBasedRandom, Reproducible) {
+	constexpr CounterBasedRandom Rand(42);
+	static_assert(Rand(1, 2) == CounterBasedRandom(42)(1, 2), "generator must be usable at compile time.");
+	CHECK(Rand(1, 0) != Rand(2, 0));
+	CHECK(Rand(1, 0) != Rand(1, 1));
+	CHECK(Rand(1, 0) != CounterBasedRandom(43)(1, 0));
+}
+
+TEST_CASE(CounterBasedRandom, GenerateRange) {
+	const CounterBasedRandom Rand(7);
+	bool Seen[11] = {};
+	for (std::uint64_t i = 0; i < 10000; i++) {
+		const int Value = Rand.Generate<int>(i, 0, -5, 5);
+		CHECK(Value >= -5 && Value <= 5);
+		if (Value >= -5 && Value <= 5) Seen[Value + 5] = true;
+	}
+	for (const bool s : Seen) CHECK(s);
+	// 全範囲を指定した場合も範囲外の値は出ない
+	CHECK_EQUAL(Rand(3, 4), Rand.Generate<std::uint64_t>(3, 4, 0, std::numeric_limits<std::uint64_t>::max()));
+	CHECK_EQUAL(9u, Rand.Generate<unsigned int>(0, 0, 9u, 9u));
+}
+
+TEST_CASE(CounterBasedRandom, SpeedManager) {
+	const CounterBasedRandom Rand(1);
+	const SpeedManager<int> Speed(100);
+	for (std::uint64_t Turn = 0; Turn < 100; Turn++) {
+		const int Point = Speed.GetParameterToCreateAttackTurn(Rand, Turn, 0, 10, 0);
+		CHECK(Point >= 100 && Point <= 110);
+		CHECK_EQUAL(Point, Speed.GetParameterToCreateAttackTurn(Rand, Turn, 0, 10, 0));
+	}
+}
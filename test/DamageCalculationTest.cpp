@@ -0,0 +1,103 @@
+#include "UnitTest.hpp"
+#include "DamageCalculation.hpp"
+#include "Skill.hpp"
+#include "CounterBasedRandom.hpp"
+#include <vector>
+#include <algorithm>
+#include <limits>
+
+TEST_CASE(DamageCalculation, Formula) {
+	CHECK_EQUAL(150, DamageCalculation::CalcDamage(100, 100, 100, 1.0f));
+	CHECK_EQUAL(300, DamageCalculation::CalcDamage(100, 100, 100, 2.0f));
+	CHECK_EQUAL(0, DamageCalculation::CalcDamage(10, 10, 1000, 2.0f));
+	CHECK_EQUAL(2147483520, DamageCalculation::CalcDamage(2000000000, 2000000000, 0, 2.0f));
+}
+
+// SIMD版とスカラー版の結果がビット単位で一致することを確認する
+TEST_CASE(DamageCalculation, SimdMatchesScalar) {
+	const CounterBasedRandom Rand(12345);
+	const float MagnificationList[] = { 0.0f, 0.5f, 1.0f, 1.5f, 2.0f, 3.3f };
+	// 端数の処理を確認するため、SIMDの幅で割り切れない要素数にする
+	constexpr size_t Num = 1003;
+	std::vector<int> Attack(Num), BasePower(Num), Defence(Num), Scalar(Num), Simd(Num);
+	std::vector<float> Magnification(Num);
+	for (size_t i = 0; i < Num; i++) {
+		// 一部は極端な値にしてintの範囲を超える場合も確認する
+		const bool Extreme = i % 17 == 0;
+		Attack[i] = Rand.Generate<int>(i, 0, Extreme ? -2000000000 : 0, Extreme ? 2000000000 : 9999);
+		BasePower[i] = Rand.Generate<int>(i, 1, Extreme ? -2000000000 : 0, Extreme ? 2000000000 : 500);
+		Defence[i] = Rand.Generate<int>(i, 2, Extreme ? -2000000000 : 0, Extreme ? 2000000000 : 9999);
+		Magnification[i] = MagnificationList[Rand.Generate<size_t>(i, 3, 0, 5)];
+	}
+	DamageCalculation::CalcDamage(Attack.data(), BasePower.data(), Defence.data(), Magnification.data(), Scalar.data(), Num, DamageCalculation::SimdLevel::Scalar);
+	for (size_t i = 0; i < Num; i++) CHECK_EQUAL(DamageCalculation::CalcDamage(Attack[i], BasePower[i], Defence[i], Magnification[i]), Scalar[i]);
+	const DamageCalculation::SimdLevel Supported = DamageCalculation::GetSupportedSimdLevel();
+	for (const DamageCalculation::SimdLevel Level : { DamageCalculation::SimdLevel::SSE2, DamageCalculation::SimdLevel::AVX2 }) {
+		if (static_cast<int>(Level) > static_cast<int>(Supported)) continue;
+		std::fill(Simd.begin(), Simd.end(), -1);
+		DamageCalculation::CalcDamage(Attack.data(), BasePower.data(), Defence.data(), Magnification.data(), Simd.data(), Num, Level);
+		CHECK(Simd == Scalar);
+	}
+}
+
+// NaN・無限大の倍率でも、SIMD版と端数を処理するスカラー版の結果が一致することを確認する
+TEST_CASE(DamageCalculation, NonFiniteMagnification) {
+	const float Infinity = std::numeric_limits<float>::infinity(), NaN = std::numeric_limits<float>::quiet_NaN();
+	const float MagnificationList[] = { Infinity, NaN, 1.0f };
+	constexpr size_t Num = 23;
+	std::vector<int> Attack(Num, 100), BasePower(Num, 50), Defence(Num), Scalar(Num), Simd(Num);
+	std::vector<float> Magnification(Num);
+	for (size_t i = 0; i < Num; i++) {
+		Defence[i] = i % 2 == 0 ? 100 : 1000;
+		Magnification[i] = MagnificationList[i % 3];
+	}
+	CHECK_EQUAL(2147483520, DamageCalculation::CalcDamage(100, 50, 100, Infinity));
+	CHECK_EQUAL(2147483520, DamageCalculation::CalcDamage(100, 50, 100, NaN));
+	CHECK_EQUAL(2147483520, DamageCalculation::CalcDamage(100, 50, 1000, Infinity));
+	DamageCalculation::CalcDamage(Attack.data(), BasePower.data(), Defence.data(), Magnification.data(), Scalar.data(), Num, DamageCalculation::SimdLevel::Scalar);
+	const DamageCalculation::SimdLevel Supported = DamageCalculation::GetSupportedSimdLevel();
+	for (const DamageCalculation::SimdLevel Level : { DamageCalculation::SimdLevel::SSE2, DamageCalculation::SimdLevel::AVX2 }) {
+		if (static_cast<int>(Level) > static_cast<int>(Supported)) continue;
+		std::fill(Simd.begin(), Simd.end(), -1);
+		DamageCalculation::CalcDamage(Attack.data(), BasePower.data(), Defence.data(), Magnification.data(), Simd.data(), Num, Level);
+		CHECK(Simd == Scalar);
+	}
+}
+
+// 攻撃力・基本攻撃力を共通の値で渡した場合も、配列で渡した場合と結果が一致することを確認する
+TEST_CASE(DamageCalculation, Broadcast) {
+	const CounterBasedRandom Rand(678);
+	constexpr size_t Num = 37;
+	std::vector<int> Attack(Num, 1234), BasePower(Num, 56), Defence(Num), Expected(Num), Actual(Num);
+	std::vector<float> Magnification(Num);
+	for (size_t i = 0; i < Num; i++) {
+		Defence[i] = Rand.Generate<int>(i, 0, 0, 9999);
+		Magnification[i] = i % 3 == 0 ? 2.0f : 0.5f;
+	}
+	for (const DamageCalculation::SimdLevel Level : { DamageCalculation::SimdLevel::Scalar, DamageCalculation::SimdLevel::SSE2, DamageCalculation::SimdLevel::AVX2 }) {
+		if (static_cast<int>(Level) > static_cast<int>(DamageCalculation::GetSupportedSimdLevel())) continue;
+		DamageCalculation::CalcDamage(Attack.data(), BasePower.data(), Defence.data(), Magnification.data(), Expected.data(), Num, Level);
+		std::fill(Actual.begin(), Actual.end(), -1);
+		DamageCalculation::CalcDamage(1234, 56, Defence.data(), Magnification.data(), Actual.data(), Num, Level);
+		CHECK(Actual == Expected);
+	}
+}
+
+TEST_CASE(DamageCalculation, CrossProduct) {
+	const std::vector<int> Attack = { 100, 200 };
+	const std::vector<SkillA> Skills = { { "Fire", 4, 50, "", ElementInfo::Fire }, { "Attack", 0, 0, "", ElementInfo::Normal } };
+	const std::vector<int> Defence = { 100, 0, 50 };
+	const std::vector<ElementInfo> DefenceElement = { ElementInfo::Ice, ElementInfo::Fire, ElementInfo::Normal };
+	std::vector<int> Damage;
+	DamageCalculation::CalcDamage(Attack, Skills, Defence, DefenceElement, Damage, 0.5f, 2.0f);
+	CHECK_EQUAL(Attack.size() * Skills.size() * Defence.size(), Damage.size());
+	for (size_t a = 0; a < Attack.size(); a++) {
+		for (size_t s = 0; s < Skills.size(); s++) {
+			for (size_t t = 0; t < Defence.size(); t++) {
+				const float Magnification = ElementAdvantageTable.GetAdvantage(DefenceElement[t], Skills[s].SkillElement, 0.5f, 2.0f);
+				CHECK_EQUAL(DamageCalculation::CalcDamage(Attack[a], Skills[s].BasePower, Defence[t], Magnification), Damage[(a * Skills.size() + s) * Defence.size() + t]);
+			}
+		}
+	}
+	CHECK_THROWS(DamageCalculation::CalcDamage(Attack, Skills, Defence, std::vector<ElementInfo>(), Damage, 0.5f, 2.0f));
+}
@@ -0,0 +1,69 @@
+#include "UnitTest.hpp"
+#include "Element.hpp"
+
+TEST_CASE(Element, DefaultTable) {
+	const Element Fire(ElementInfo::Fire);
+	CHECK_EQUAL(2.0f, Fire.Advantage(ElementInfo::Ice));
+	CHECK_EQUAL(0.5f, Fire.Advantage(ElementInfo::Fire));
+	CHECK_EQUAL(1.0f, Fire.Advantage(ElementInfo::Shine));
+	CHECK_EQUAL(1.0f, Element().Advantage(ElementInfo::Dark));
+	// 倍率を指定した場合はその倍率を使用する
+	CHECK_EQUAL(3.0f, Fire.Advantage(ElementInfo::Earth, 0.25f, 3.0f));
+	CHECK_EQUAL(0.25f, Fire.Advantage(ElementInfo::Wind, 0.25f, 3.0f));
+}
+
+TEST_CASE(Element, CustomTable) {
+	constexpr ElementInfo Poison = static_cast<ElementInfo>(8);
+	AdvantageTable<> Table;
+	Table.Register(Poison, { ElementInfo::Shine }, { Poison });
+	Table.SetMagnification(0.0f, 1.5f);
+	CHECK(Table.GetAdvantageType(Poison, ElementInfo::Shine) == AdvantageType::Weak);
+	CHECK_EQUAL(1.5f, Table.GetAdvantage(Poison, ElementInfo::Shine));
+	CHECK_EQUAL(0.0f, Table.GetAdvantage(Poison, Poison));
+	CHECK_EQUAL(1.0f, Table.GetAdvantage(static_cast<ElementInfo>(100), Poison));
+	CHECK_THROWS(Table.Register(static_cast<ElementInfo>(16), {}, {}));
+	CHECK_THROWS(AdvantageInfo(ElementInfo::Normal));
+}
+
+TEST_CASE(Element, PerPairMultiplier) {
+	AdvantageTable<> Table;
+	Table.SetMultiplier(ElementInfo::Fire, ElementInfo::Ice, 3.0f);
+	Table.SetMultiplier(ElementInfo::Dark, ElementInfo::Normal, 1.25f);
+	CHECK_EQUAL(3.0f, Table.GetAdvantage(ElementInfo::Fire, ElementInfo::Ice));
+	// 同じ弱点でも別の組み合わせは変わらない
+	CHECK_EQUAL(2.0f, Table.GetAdvantage(ElementInfo::Fire, ElementInfo::Earth));
+	CHECK_EQUAL(1.25f, Table.GetAdvantage(ElementInfo::Dark, ElementInfo::Normal));
+	CHECK(Table.GetAdvantageType(ElementInfo::Fire, ElementInfo::Ice) == AdvantageType::Weak);
+	// 倍率を指定した場合は相性のみを使用する
+	CHECK_EQUAL(4.0f, Table.GetAdvantage(ElementInfo::Fire, ElementInfo::Ice, 0.5f, 4.0f));
+	// 別の表を渡した場合はElementAdvantageTableを参照しない
+	const Element Fire(ElementInfo::Fire);
+	CHECK_EQUAL(3.0f, Fire.Advantage(ElementInfo::Ice, Table));
+	CHECK_EQUAL(2.0f, Fire.Advantage(ElementInfo::Ice));
+	Table.SetAdvantageType(ElementInfo::Fire, ElementInfo::Ice, AdvantageType::Beauty);
+	CHECK_EQUAL(0.5f, Table.GetAdvantage(ElementInfo::Fire, ElementInfo::Ice));
+	Table.SetMagnification(0.25f, 1.5f);
+	CHECK_EQUAL(1.0f, Table.GetAdvantage(ElementInfo::Dark, ElementInfo::Normal));
+	CHECK_EQUAL(1.5f, Table.GetAdvantage(ElementInfo::Fire, ElementInfo::Earth));
+	CHECK_THROWS(Table.SetMultiplier(static_cast<ElementInfo>(16), ElementInfo::Fire, 1.0f));
+}
+
+TEST_CASE(Element, ConstexprTable) {
+	constexpr AdvantageTable<8> Table{};
+	static_assert(Table.GetAdvantage(ElementInfo::Shine, ElementInfo::Dark) == 2.0f, "table must be usable at compile time.");
+	CHECK(Table.GetAdvantageType(ElementInfo::Dark, ElementInfo::Dark) == AdvantageType::Beauty);
+}
+
+TEST_CASE(Element, ParseName) {
+	ElementInfo Result = ElementInfo::Normal;
+	CHECK(TryParseElement(std::string_view("thunder"), Result));
+	CHECK_EQUAL(ElementInfo::Thunder, Result);
+	CHECK(TryParseElement(std::wstring_view(L"fire"), Result));
+	CHECK_EQUAL(ElementInfo::Fire, Result);
+	CHECK(!TryParseElement(std::string_view("thunde"), Result));
+	CHECK(!TryParseElement(std::string_view("Fire"), Result));
+	CHECK(!TryParseElement(std::string_view(""), Result));
+	CHECK_EQUAL(ElementInfo::Fire, Result);
+	CHECK_EQUAL(ElementInfo::Dark, Element("dark").Elem);
+	CHECK_EQUAL(ElementInfo::Normal, Element("unknown").Elem);
+}
@@ -0,0 +1,137 @@
+#include "UnitTest.hpp"
+#include "PossibleChangeStatus.hpp"
+#include "UseDamageCalculationParameter.hpp"
+#include "LevelManager.hpp"
+#include "CharacterRoster.hpp"
+#include "AtomicPossibleChangeStatus.hpp"
+#include "Instrumentation.hpp"
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+	std::uint64_t MutationNum(const Instrumentation::StatKind Kind) { return Instrumentation::GetCounter().Mutation[static_cast<size_t>(Kind)]; }
+	std::uint64_t ClampMaxNum(const Instrumentation::StatKind Kind) { return Instrumentation::GetCounter().ClampMax[static_cast<size_t>(Kind)]; }
+	std::uint64_t ClampMinNum(const Instrumentation::StatKind Kind) { return Instrumentation::GetCounter().ClampMin[static_cast<size_t>(Kind)]; }
+	void DiscardEvents() {
+		std::vector<Instrumentation::Event> Events;
+		Instrumentation::Drain(Events);
+	}
+}
+
+TEST_CASE(Instrumentation, Counter) {
+	using Instrumentation::StatKind;
+	DiscardEvents();
+	const std::uint64_t Mutation = MutationNum(StatKind::Status), ClampMax = ClampMaxNum(StatKind::Status), ClampMin = ClampMinNum(StatKind::Status);
+	const std::uint64_t ParameterMutation = MutationNum(StatKind::Parameter);
+	PossibleChangeStatus<int> HP(100, 100, 0);
+	HP -= 30;
+	HP -= 200;
+	HP += 500;
+	CHECK_EQUAL(100, *HP);
+	CHECK_EQUAL(Mutation + 3, MutationNum(StatKind::Status));
+	CHECK_EQUAL(ClampMax + 1, ClampMaxNum(StatKind::Status));
+	CHECK_EQUAL(ClampMin + 1, ClampMinNum(StatKind::Status));
+	// 二項演算の結果を代入しても種類は引き継がれる
+	UseDamageCalculationParameter<int> Attack(50, 999, 0);
+	standard::number<int> Copied = Attack + 10;
+	Copied += 1;
+	CHECK_EQUAL(ParameterMutation + 1, MutationNum(StatKind::Parameter));
+	std::vector<Instrumentation::Event> Events;
+	Instrumentation::Drain(Events);
+	CHECK_EQUAL(4u, Events.size());
+	CHECK(Events[0].Object == static_cast<const void*>(&HP));
+	CHECK_EQUAL(100.0, Events[0].Before);
+	CHECK_EQUAL(70.0, Events[0].After);
+	CHECK_EQUAL(Instrumentation::EventType::ClampMin, Events[1].Type);
+	CHECK_EQUAL(-130.0, Events[1].Requested);
+	CHECK_EQUAL(Instrumentation::EventType::ClampMax, Events[2].Type);
+	CHECK_EQUAL(StatKind::Parameter, Events[3].Kind);
+	// 丸めを行わない直接の設定は、範囲外の値でも丸めとして数えない
+	HP.ChangeCurrentNumToReserevedNum(500);
+	CHECK_EQUAL(Mutation + 4, MutationNum(StatKind::Status));
+	CHECK_EQUAL(ClampMax + 1, ClampMaxNum(StatKind::Status));
+	Events.clear();
+	Instrumentation::Drain(Events);
+	CHECK_EQUAL(1u, Events.size());
+	CHECK_EQUAL(Instrumentation::EventType::Set, Events[0].Type);
+	CHECK_EQUAL(500.0, Events[0].After);
+}
+
+TEST_CASE(Instrumentation, LevelUpAndRoster) {
+	using Instrumentation::StatKind;
+	DiscardEvents();
+	const std::uint64_t LevelUp = Instrumentation::GetCounter().LevelUp;
+	LevelManager Manager(LevelCurve({ 10, 30, 60, 100 }));
+	CHECK_EQUAL(2u, Manager.AddExp(30));
+	CHECK_EQUAL(LevelUp + 2, Instrumentation::GetCounter().LevelUp);
+
+	const std::uint64_t Speed = MutationNum(StatKind::Speed), HPClampMin = ClampMinNum(StatKind::Status);
+	CharacterRoster<int> Roster;
+	for (int i = 0; i < 3; i++) Roster.Add(PossibleChangeStatus<int>(100, 100, 0), PossibleChangeStatus<int>(10, 10, 0),
+		UseDamageCalculationParameter<int>(10, 99, 0), UseDamageCalculationParameter<int>(10, 99, 0), SpeedManager<int>(10, 99, 1));
+	const int Damage[] = { 50, 150, 100 };
+	Roster.Subtract(RosterStatus::HP, Damage);
+	Roster.AddAll(RosterStatus::Speed, 1);
+	CHECK_EQUAL(HPClampMin + 1, ClampMinNum(StatKind::Status));
+	CHECK_EQUAL(Speed + 3, MutationNum(StatKind::Speed));
+	std::vector<Instrumentation::Event> Events;
+	Instrumentation::Drain(Events);
+	size_t LevelUpEvent = 0;
+	for (const Instrumentation::Event& e : Events) if (e.Type == Instrumentation::EventType::LevelUp) LevelUpEvent++;
+	CHECK_EQUAL(1u, LevelUpEvent);
+}
+
+TEST_CASE(Instrumentation, MultiThread) {
+	using Instrumentation::StatKind;
+	DiscardEvents();
+	const std::uint64_t Mutation = MutationNum(StatKind::AtomicStatus);
+	AtomicPossibleChangeStatus<int> HP(1000000, 1000000, 0);
+	constexpr int ThreadNum = 4, Count = 500;
+	std::vector<std::thread> Threads;
+	for (int t = 0; t < ThreadNum; t++) Threads.emplace_back([&HP] { for (int i = 0; i < Count; i++) HP.Subtract(1); });
+	for (std::thread& t : Threads) t.join();
+	// 終了したスレッドの回数も合計に残る
+	CHECK_EQUAL(Mutation + ThreadNum * Count, MutationNum(StatKind::AtomicStatus));
+	std::vector<Instrumentation::Event> Events;
+	CHECK_EQUAL(static_cast<size_t>(ThreadNum * Count), Instrumentation::Drain(Events));
+	CHECK_EQUAL(Mutation + ThreadNum * Count, MutationNum(StatKind::AtomicStatus));
+	CHECK_EQUAL(0u, Instrumentation::Drain(Events));
+}
+
+TEST_CASE(Instrumentation, Disabled) {
+	using Instrumentation::StatKind;
+	DiscardEvents();
+	const std::uint64_t Mutation = MutationNum(StatKind::Status);
+	PossibleChangeStatus<int> MP(10, 10, 0);
+	Instrumentation::SetEnabled(false);
+	MP -= 1;
+	Instrumentation::SetEnabled(true);
+	CHECK_EQUAL(9, *MP);
+	CHECK_EQUAL(Mutation, MutationNum(StatKind::Status));
+	std::vector<Instrumentation::Event> Events;
+	CHECK_EQUAL(0u, Instrumentation::Drain(Events));
+}
+
+TEST_CASE(Instrumentation, TraceFile) {
+	DiscardEvents();
+	const std::string FilePath = "InstrumentationTrace.csv";
+	{
+		Instrumentation::TraceFile Trace(FilePath);
+		PossibleChangeStatus<int> HP(100, 100, 0);
+		HP -= 120;
+		CHECK_EQUAL(1u, Trace.Flush());
+	}
+	std::ifstream Stream(FilePath);
+	std::string Header, Line;
+	std::getline(Stream, Header);
+	std::getline(Stream, Line);
+	CHECK_EQUAL(std::string("time_ns,thread,kind,event,object,before,after,requested"), Header);
+	CHECK(Line.find(",status,clamp_min,") != std::string::npos);
+	CHECK(Line.find(",100,0,-20") != std::string::npos);
+	Stream.close();
+	std::remove(FilePath.c_str());
+	CHECK_THROWS(Instrumentation::TraceFile("/nonexistent/directory/trace.csv"));
+}
@@ -0,0 +1,41 @@
+#include "UnitTest.hpp"
+#include "LevelManager.hpp"
+
+TEST_CASE(LevelManager, AddExp) {
+	const LevelCurve Curve({ 10, 30, 60, 100 });
+	LevelManager Manager(Curve);
+	CHECK_EQUAL(1u, Manager.GetCurrentLevel());
+	CHECK_EQUAL(10u, Manager.GetExpPointNeededToRaiseNextLevel());
+	CHECK_EQUAL(0u, Manager.AddExp(9));
+	CHECK_EQUAL(1u, Manager.AddExp(1));
+	CHECK_EQUAL(2u, Manager.GetCurrentLevel());
+	// 一度に複数のレベルが上がる
+	CHECK_EQUAL(2u, Manager.AddExp(55));
+	CHECK_EQUAL(4u, Manager.GetCurrentLevel());
+	CHECK_EQUAL(35u, Manager.GetExpPointNeededToRaiseNextLevel());
+	// 上限を超える経験値は切り捨てられる
+	CHECK_EQUAL(1u, Manager.AddExp(static_cast<size_t>(-1)));
+	CHECK_EQUAL(5u, Manager.GetCurrentLevel());
+	CHECK_EQUAL(100u, Manager.GetCurrentExp());
+	CHECK_EQUAL(0u, Manager.GetExpPointNeededToRaiseNextLevel());
+	CHECK_EQUAL(0u, Manager.AddExp(10));
+}
+
+TEST_CASE(LevelManager, InitialExp) {
+	const LevelManager Manager(std::vector<size_t>{ 10, 30, 60 }, 45);
+	CHECK_EQUAL(3u, Manager.GetCurrentLevel());
+	CHECK_EQUAL(15u, Manager.GetExpPointNeededToRaiseNextLevel());
+	CHECK_THROWS(LevelCurve(std::vector<size_t>{}));
+	CHECK_THROWS(LevelCurve(std::vector<size_t>{ 30, 10 }));
+}
+
+TEST_CASE(LevelManager, DistributeExp) {
+	const LevelCurve Curve({ 10, 30, 60 });
+	std::vector<LevelManager> Party = { LevelManager(Curve, 0), LevelManager(Curve, 25), LevelManager(Curve, 60) };
+	std::vector<unsigned int> Raised;
+	LevelManager::DistributeExp(Party, 10, &Raised);
+	CHECK_EQUAL(1u, Raised[0]);
+	CHECK_EQUAL(1u, Raised[1]);
+	CHECK_EQUAL(0u, Raised[2]);
+	CHECK_EQUAL(4u, Party[2].GetLevelCurve().GetMaxLevel());
+}
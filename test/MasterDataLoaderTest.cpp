@@ -0,0 +1,57 @@
+#include "UnitTest.hpp"
+#include "MasterDataLoader.hpp"
+#include "SkillTable.hpp"
+
+TEST_CASE(MasterDataLoader, ReadLine) {
+	DelimitedTextReaderA Reader("# comment\r\na,b,,c\r\n\r\nd\n");
+	std::vector<std::string_view> Fields;
+	CHECK(Reader.ReadLine(Fields));
+	CHECK_EQUAL(2u, Reader.GetLineNumber());
+	CHECK((Fields == std::vector<std::string_view>{ "a", "b", "", "c" }));
+	CHECK(Reader.ReadLine(Fields));
+	CHECK((Fields == std::vector<std::string_view>{ "d" }));
+	CHECK(!Reader.ReadLine(Fields));
+}
+
+TEST_CASE(MasterDataLoader, LoadSkills) {
+	DelimitedTextReaderW Reader(L"ファイア\t4\t30\t炎で攻撃\tfire\nブリザド\t6\t45\t氷で攻撃\tice\n", L'\t');
+	std::vector<SkillW> Skills;
+	CHECK(MasterDataLoader::LoadSkills(Reader, Skills) == std::errc());
+	CHECK_EQUAL(2u, Skills.size());
+	CHECK(Skills[1].Name == L"ブリザド");
+	CHECK_EQUAL(45, Skills[1].BasePower);
+	CHECK_EQUAL(ElementInfo::Ice, Skills[1].SkillElement);
+	DelimitedTextReaderA Broken("Fire,4,30,desc,fire\nIce,x,45,desc,ice\n");
+	std::vector<SkillA> Partial;
+	CHECK(MasterDataLoader::LoadSkills(Broken, Partial) == std::errc::invalid_argument);
+	CHECK_EQUAL(2u, Broken.GetLineNumber());
+}
+
+// BasicSkillViewに読み込む場合は元のテキストを参照し、そのまま表を作成できる
+TEST_CASE(MasterDataLoader, LoadSkillViews) {
+	const std::string_view Text = "Fire,4,30,burn,fire\nBlizzard,6,45,freeze,ice\nFira,8,60,burn,fire\n";
+	DelimitedTextReaderA Reader(Text);
+	std::vector<SkillViewA> Skills;
+	CHECK(MasterDataLoader::LoadSkills(Reader, Skills) == std::errc());
+	CHECK_EQUAL(3u, Skills.size());
+	CHECK(Skills[1].Name == "Blizzard");
+	CHECK(Skills[1].Name.data() >= Text.data() && Skills[1].Name.data() < Text.data() + Text.size());
+	CHECK_EQUAL(ElementInfo::Ice, Skills[1].SkillElement);
+	const SkillTableA Table(Skills);
+	const SkillId Id = Table.Find("Fira");
+	CHECK(Id != SkillId::Invalid);
+	CHECK_EQUAL(60, Table.GetBasePower(Id));
+	CHECK(Table.GetDescription(Id) == "burn");
+	CHECK_EQUAL(2u, Table.FindByElement(ElementInfo::Fire).size());
+}
+
+TEST_CASE(MasterDataLoader, LoadCharacters) {
+	DelimitedTextReaderA Reader("300,40,120,80,55\n150,90,60,50,70\n");
+	CharacterRoster<int> Roster;
+	CHECK(MasterDataLoader::LoadCharacters(Reader, Roster) == std::errc());
+	CHECK_EQUAL(2u, Roster.Size());
+	CHECK_EQUAL(300, Roster.GetMax(RosterStatus::HP, 0));
+	CHECK_EQUAL(70, Roster.Get(RosterStatus::Speed, 1));
+	DelimitedTextReaderA Short("1,2,3\n");
+	CHECK(MasterDataLoader::LoadCharacters(Short, Roster) == std::errc::invalid_argument);
+}
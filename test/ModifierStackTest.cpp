@@ -0,0 +1,89 @@
+#include "UnitTest.hpp"
+#include "ModifierStack.hpp"
+#include "CounterBasedRandom.hpp"
+#include <vector>
+#include <limits>
+#include <type_traits>
+
+TEST_CASE(ModifierStack, Modifier) {
+	ModifierStack<int> Attack(UseDamageCalculationParameter<int>(100, 999, 0));
+	const ModifierId Add = Attack.AddModifier(ModifierType::Additive, 20);
+	CHECK_EQUAL(120, *Attack);
+	Attack.AddModifier(ModifierType::Multiplicative, 1.5);
+	CHECK_EQUAL(180, *Attack);
+	Attack.AddModifier(ModifierType::Multiplicative, 10.0);
+	CHECK_EQUAL(999, *Attack);
+	Attack.AddModifier(ModifierType::Multiplicative, 0.0);
+	CHECK_EQUAL(0, *Attack);
+	Attack.ClearModifiers();
+	CHECK_EQUAL(100, *Attack);
+	CHECK(!Attack.RemoveModifier(Add));
+	CHECK_EQUAL(50, Attack.PowerUp(50));
+	Attack.AddModifier(ModifierType::Additive, -30);
+	CHECK_EQUAL(120, *Attack);
+	Attack.Reset();
+	CHECK_EQUAL(0u, Attack.GetModifierNum());
+	CHECK_EQUAL(100, *Attack);
+}
+
+// 範囲外の値をTに変換せず、doubleのまま最大値・最小値に丸める
+TEST_CASE(ModifierStack, ClampBeforeConversion) {
+	ModifierStack<unsigned int> Speed(UseDamageCalculationParameter<unsigned int>(10u, 100u, 0u));
+	Speed.AddModifier(ModifierType::Additive, -50.0);
+	CHECK_EQUAL(0u, *Speed);
+	Speed.AddModifier(ModifierType::Multiplicative, std::numeric_limits<double>::quiet_NaN());
+	CHECK_EQUAL(0u, *Speed);
+	constexpr long long Max = std::numeric_limits<long long>::max();
+	ModifierStack<long long> Exp(UseDamageCalculationParameter<long long>(Max / 2, Max, std::numeric_limits<long long>::min()));
+	Exp.AddModifier(ModifierType::Multiplicative, 2.0);
+	CHECK_EQUAL(Max, *Exp);
+	Exp.AddModifier(ModifierType::Multiplicative, -1e30);
+	CHECK_EQUAL(std::numeric_limits<long long>::min(), *Exp);
+}
+
+TEST_CASE(ModifierStack, Expiry) {
+	ModifierStack<int> Defence(UseDamageCalculationParameter<int>(100, 999, 0));
+	ModifierStack<int>::Wheel Timer;
+	Defence.AddModifier(ModifierType::Additive, 50, 3, Timer);
+	const ModifierId Removed = Defence.AddModifier(ModifierType::Multiplicative, 2.0, 2, Timer);
+	Defence.AddModifier(ModifierType::Multiplicative, 0.5, 100, Timer);
+	CHECK_EQUAL(150, *Defence);
+	ModifierStack<int>::AdvanceTurn(Timer);
+	CHECK_EQUAL(150, *Defence);
+	CHECK(Defence.RemoveModifier(Removed));
+	CHECK_EQUAL(75, *Defence);
+	ModifierStack<int>::AdvanceTurn(Timer);
+	CHECK_EQUAL(75, *Defence);
+	ModifierStack<int>::AdvanceTurn(Timer);
+	CHECK_EQUAL(50, *Defence);
+	Timer.AdvanceTo(100, [](ModifierStack<int>::Expiry& e) { e.Stack->RemoveModifier(e.Id); });
+	CHECK_EQUAL(100, *Defence);
+	CHECK_EQUAL(0u, Timer.Size());
+}
+
+// TimerWheelが登録元のアドレスを保持するため、コピー・移動はできない
+static_assert(!std::is_copy_constructible<ModifierStack<int>>::value && !std::is_copy_assignable<ModifierStack<int>>::value, "ModifierStack must not be copyable.");
+static_assert(!std::is_move_constructible<ModifierStack<int>>::value && !std::is_move_assignable<ModifierStack<int>>::value, "ModifierStack must not be movable.");
+
+// 期限が様々な多数の登録が、全て指定したターンに取り出される
+TEST_CASE(ModifierStack, TimerWheel) {
+	const CounterBasedRandom Rand(3);
+	constexpr std::uint64_t Start = 1000;
+	TimerWheel<std::uint64_t> Timer(Start);
+	std::uint64_t Last = 0;
+	for (std::uint64_t i = 0; i < 100000; i++) {
+		const std::uint64_t Range = i % 10 == 0 ? 30000000 : i % 3 == 0 ? 100000 : 300;
+		const std::uint64_t Expire = Start + Rand.Generate<std::uint64_t>(i, 0, 0, Range);
+		Timer.Schedule(Expire, Expire);
+		Last = std::max(Last, Expire);
+	}
+	size_t Fired = 0, Wrong = 0;
+	Timer.AdvanceTo(Last, [&Timer, &Fired, &Wrong](const std::uint64_t Expire) {
+		Fired++;
+		// 現在のターン以前を指定したものは次のターンに取り出される
+		if (Timer.GetCurrentTurn() != std::max(Expire, Start + 1)) Wrong++;
+	});
+	CHECK_EQUAL(100000u, Fired);
+	CHECK_EQUAL(0u, Wrong);
+	CHECK_EQUAL(0u, Timer.Size());
+}
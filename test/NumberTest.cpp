@@ -0,0 +1,120 @@
+#include "UnitTest.hpp"
+#include "Number.hpp"
+#include <cstdint>
+#include <limits>
+
+namespace {
+	template<typename T>
+	T Saturate(const long long Value) {
+		if (Value > static_cast<long long>(std::numeric_limits<T>::max())) return std::numeric_limits<T>::max();
+		if (Value < static_cast<long long>(std::numeric_limits<T>::min())) return std::numeric_limits<T>::min();
+		return static_cast<T>(Value);
+	}
+	// 8bitの全ての組み合わせについて、幅の広い型で計算して飽和させた値と比較する
+	template<typename T>
+	void CheckAllPairs() {
+		size_t Mismatch = 0;
+		for (int a = std::numeric_limits<T>::min(); a <= std::numeric_limits<T>::max(); a++) {
+			for (int b = std::numeric_limits<T>::min(); b <= std::numeric_limits<T>::max(); b++) {
+				const T x = static_cast<T>(a), y = static_cast<T>(b);
+				if (standard::saturating_add(x, y) != Saturate<T>(a + b)) Mismatch++;
+				if (standard::saturating_sub(x, y) != Saturate<T>(a - b)) Mismatch++;
+				if (standard::saturating_mul(x, y) != Saturate<T>(a * b)) Mismatch++;
+				if (b != 0 && standard::saturating_div(x, y) != Saturate<T>(a / b)) Mismatch++;
+			}
+		}
+		CHECK_EQUAL(0u, Mismatch);
+	}
+}
+
+TEST_CASE(Number, SaturatingInt8Exhaustive) { CheckAllPairs<std::int8_t>(); }
+TEST_CASE(Number, SaturatingUInt8Exhaustive) { CheckAllPairs<std::uint8_t>(); }
+
+TEST_CASE(Number, SaturatingEdgeCases) {
+	constexpr long long Max = std::numeric_limits<long long>::max(), Min = std::numeric_limits<long long>::min();
+	CHECK_EQUAL(Max, standard::saturating_add(Max, 1LL));
+	CHECK_EQUAL(Min, standard::saturating_add(Min, -1LL));
+	CHECK_EQUAL(Min, standard::saturating_sub(Min, 1LL));
+	CHECK_EQUAL(Max, standard::saturating_sub(0LL, Min));
+	CHECK_EQUAL(Max, standard::saturating_mul(Min, -1LL));
+	CHECK_EQUAL(Max, standard::saturating_mul(-1LL, Min));
+	CHECK_EQUAL(-Max, standard::saturating_mul(-1LL, Max));
+	CHECK_EQUAL(Max, standard::saturating_mul(Min, Min));
+	CHECK_EQUAL(Min, standard::saturating_mul(Min, 2LL));
+	CHECK_EQUAL(Min, standard::saturating_mul(-2LL, Max));
+	CHECK_EQUAL(-6LL, standard::saturating_mul(-2LL, 3LL));
+	CHECK_EQUAL(Min, standard::saturating_mul(Max, -2LL));
+	CHECK_EQUAL(Max, standard::saturating_div(Min, -1LL));
+	constexpr std::uint64_t UMax = std::numeric_limits<std::uint64_t>::max();
+	CHECK_EQUAL(UMax, standard::saturating_add(UMax, std::uint64_t(1)));
+	CHECK_EQUAL(0u, standard::saturating_sub(std::uint64_t(1), std::uint64_t(2)));
+	CHECK_EQUAL(UMax, standard::saturating_mul(UMax / 2, std::uint64_t(3)));
+	static_assert(standard::saturating_add(std::numeric_limits<int>::max(), 1) == std::numeric_limits<int>::max(), "saturating_add must be constexpr.");
+}
+
+TEST_CASE(Number, SaturatingSpan) {
+	unsigned int Dst[] = { 0u, 5u, std::numeric_limits<unsigned int>::max() - 1 };
+	const unsigned int Src[] = { 1u, 10u, 5u };
+	standard::saturating_sub(Dst, Src, 3);
+	CHECK_EQUAL(0u, Dst[0]);
+	CHECK_EQUAL(0u, Dst[1]);
+	CHECK_EQUAL(std::numeric_limits<unsigned int>::max() - 6, Dst[2]);
+	int Hp[] = { 10, 90, 50 };
+	const int Heal[] = { 5, 50, -100 };
+	standard::saturating_add(Hp, Heal, 3, 100, 0);
+	CHECK_EQUAL(15, Hp[0]);
+	CHECK_EQUAL(100, Hp[1]);
+	CHECK_EQUAL(0, Hp[2]);
+}
+
+TEST_CASE(Number, OperatorsClampToBounds) {
+	standard::number<unsigned int> Exp(10u, 100u, 0u);
+	CHECK_EQUAL(0u, (Exp - standard::number<unsigned int>(20u)).Get());
+	CHECK_EQUAL(100u, (Exp * standard::number<unsigned int>(50u)).Get());
+	Exp -= 20u;
+	CHECK_EQUAL(0u, Exp.Get());
+	Exp += std::numeric_limits<unsigned int>::max();
+	CHECK_EQUAL(100u, Exp.Get());
+}
+
+TEST_CASE(Number, BoundsPolicies) {
+	using Fixed = standard::number<int, standard::static_bounds<int, 999, 0>>;
+	static_assert(sizeof(Fixed) == sizeof(int), "static_bounds must not add storage.");
+	Fixed Value(2000);
+	CHECK_EQUAL(999, Value.Get());
+	Value -= 5000;
+	CHECK_EQUAL(0, Value.Get());
+	struct Tag {};
+	using Shared = standard::number<int, standard::shared_bounds<int, Tag>>;
+	static_assert(sizeof(Shared) == sizeof(int), "shared_bounds must not add storage.");
+	standard::shared_bounds<int, Tag>::set_bounds(50, -50);
+	CHECK_EQUAL(50, Shared(100).Get());
+	CHECK_EQUAL(-50, Shared(-100).Get());
+	CHECK_THROWS(standard::shared_bounds<int, Tag>::set_bounds(-1, 1));
+}
+
+TEST_CASE(Number, Parse) {
+	int Value = 7;
+	CHECK(standard::parse(std::string_view("-123"), Value) == std::errc());
+	CHECK_EQUAL(-123, Value);
+	CHECK(standard::parse(std::string_view("12a"), Value) == std::errc::invalid_argument);
+	CHECK(standard::parse(std::string_view(""), Value) == std::errc::invalid_argument);
+	CHECK(standard::parse(std::string_view("99999999999"), Value) == std::errc::result_out_of_range);
+	CHECK_EQUAL(-123, Value);
+	CHECK(standard::parse(std::wstring_view(L"ff"), Value, 16) == std::errc());
+	CHECK_EQUAL(255, Value);
+	CHECK(standard::parse(std::wstring_view(L"あ"), Value) == std::errc::invalid_argument);
+	double Rate = 0.0;
+	CHECK(standard::parse(std::string_view("1.25"), Rate) == std::errc());
+	CHECK_EQUAL(1.25, Rate);
+	standard::number<int> Bounded(0, 100, 0);
+	CHECK(standard::parse(std::string_view("500"), Bounded) == std::errc());
+	CHECK_EQUAL(100, Bounded.Get());
+	CHECK_EQUAL(100, Bounded.GetMax());
+}
+
+TEST_CASE(Number, LegacyConversion) {
+	CHECK_EQUAL(-9000000000LL, standard::stoll(std::string("-9000000000")).Get());
+	CHECK_EQUAL(18000000000ULL, standard::stoull(std::wstring(L"18000000000")).Get());
+	CHECK_EQUAL(42, standard::stoi(std::string("42")).Get());
+}
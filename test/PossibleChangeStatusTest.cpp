@@ -0,0 +1,36 @@
+#include "UnitTest.hpp"
+#include "PossibleChangeStatus.hpp"
+#include "UseDamageCalculationParameter.hpp"
+
+TEST_CASE(PossibleChangeStatus, SingleArgument) {
+	// 最大値・最小値を保持する場合、引数は最大値
+	PossibleChangeStatus<int> HP(300);
+	CHECK_EQUAL(300, *HP);
+	CHECK_EQUAL(300, HP.GetMax());
+	CHECK_EQUAL(0, HP.GetMin());
+	// 最大値・最小値が固定の場合、引数は現在値
+	PossibleChangeStatus<int, standard::static_bounds<int, 999, 0>> MP(20);
+	CHECK_EQUAL(20, *MP);
+	CHECK_EQUAL(999, MP.GetMax());
+}
+
+TEST_CASE(PossibleChangeStatus, ClampAndRatio) {
+	PossibleChangeStatus<unsigned int> HP(50u, 200u, 0u);
+	HP -= 80u;
+	CHECK(HP.IsMin());
+	HP += 1000u;
+	CHECK(HP.IsMax());
+	HP -= 100u;
+	CHECK_EQUAL(0.5f, HP.GetRatio());
+}
+
+TEST_CASE(PossibleChangeStatus, UseDamageCalculationParameterPowerUpAndReset) {
+	UseDamageCalculationParameter<int> Attack(100, 150, 50);
+	CHECK_EQUAL(50, Attack.PowerUp(80));
+	CHECK_EQUAL(150, *Attack);
+	CHECK_EQUAL(100, Attack.PowerDown(200));
+	CHECK_EQUAL(50, *Attack);
+	Attack.Reset();
+	CHECK_EQUAL(100, *Attack);
+	CHECK_EQUAL(100, Attack.GetDefault());
+}
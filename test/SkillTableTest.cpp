@@ -0,0 +1,108 @@
+#include "UnitTest.hpp"
+#include "SkillTable.hpp"
+#include <filesystem>
+#include <vector>
+#include <string>
+
+namespace {
+	std::vector<SkillA> CreateSkills() {
+		return {
+			{ "Fire", 4, 30, "Small fire", ElementInfo::Fire },
+			{ "Blizzard", 6, 45, "Ice storm", ElementInfo::Ice },
+			{ "Flare", 12, 90, "Big fire", ElementInfo::Fire },
+			{ "Slash", 0, 20, "", ElementInfo::Normal },
+		};
+	}
+	void CheckTable(const SkillTableA& Table) {
+		CHECK_EQUAL(4u, Table.Size());
+		const SkillId Id = Table.Find("Blizzard");
+		CHECK(Id != SkillId::Invalid);
+		CHECK(Table.GetName(Id) == "Blizzard");
+		CHECK(Table.GetDescription(Id) == "Ice storm");
+		CHECK_EQUAL(6, Table.GetUseMP(Id));
+		CHECK_EQUAL(45, Table.GetBasePower(Id));
+		CHECK_EQUAL(ElementInfo::Ice, Table.GetElement(Id));
+		CHECK(Table.Find("Thunder") == SkillId::Invalid);
+		const SkillIdRange Fire = Table.FindByElement(ElementInfo::Fire);
+		CHECK_EQUAL(2u, Fire.size());
+		for (const SkillId Id : Fire) CHECK_EQUAL(ElementInfo::Fire, Table.GetElement(Id));
+		CHECK(Table.GetName(Fire[1]) == "Flare");
+		const SkillIdRange Dark = Table.FindByElement(ElementInfo::Dark);
+		CHECK(Dark.empty());
+		CHECK(Table.Get(Table.Find("Slash")).Name == "Slash");
+	}
+}
+
+TEST_CASE(SkillTable, Build) {
+	const SkillTableA Table(CreateSkills());
+	CheckTable(Table);
+	std::vector<SkillA> Duplicated = CreateSkills();
+	Duplicated.push_back(Duplicated.front());
+	CHECK_THROWS(SkillTableA{ Duplicated });
+}
+
+TEST_CASE(SkillTable, ViewAndLoad) {
+	const SkillTableA Table(CreateSkills());
+	CheckTable(SkillTableA::View(Table.GetData(), Table.GetDataSize()));
+	const std::string Path = (std::filesystem::temp_directory_path() / "RPGLibrarySkillTableTest.bin").string();
+	Table.Save(Path);
+	CheckTable(SkillTableA::Load(Path));
+	std::filesystem::remove(Path);
+	const unsigned char Broken[64] = {};
+	CHECK_THROWS(SkillTableA::View(Broken, sizeof(Broken)));
+	CHECK_THROWS(SkillTableA::Load(Path));
+}
+
+// 壊れたバイナリは読み込み時に検出する
+TEST_CASE(SkillTable, Malformed) {
+	const SkillTableA Table(CreateSkills());
+	const std::uint32_t* Source = static_cast<const std::uint32_t*>(Table.GetData());
+	const std::vector<std::uint32_t> Original(Source, Source + (Table.GetDataSize() + 3) / 4);
+	// ヘッダーは[Magic, Version, CharSize, SkillNum, BucketNum, ElementNum, StringLength, Reserved]、続くRecordは７要素
+	const auto Corrupt = [&Original, &Table](const size_t Index, const std::uint32_t Value) {
+		std::vector<std::uint32_t> Data = Original;
+		Data[Index] = Value;
+		return SkillTableA::View(Data.data(), Table.GetDataSize());
+	};
+	CHECK_THROWS(Corrupt(4, 0));
+	CHECK_THROWS(Corrupt(4, 6));
+	CHECK_THROWS(Corrupt(4, 0x80000000u));
+	CHECK_THROWS(Corrupt(3, 0xFFFFFFFFu));
+	CHECK_THROWS(Corrupt(6, 0xFFFFFFFFu));
+	CHECK_THROWS(Corrupt(8, 0xFFFFFFF0u));
+	CHECK_THROWS(Corrupt(9, 1000));
+	CHECK_THROWS(Corrupt(8 + 6, 100));
+	// ElementSkillの先頭(Header + Record[4] + NameBucket[8] + ElementOffset)
+	CHECK_THROWS(Corrupt(8 + 7 * 4 + 8 + Original[5] + 1, 4));
+	CHECK_THROWS(SkillTableA::View(Original.data(), Table.GetDataSize() - 1));
+}
+
+// 名前のハッシュは文字を符号なしとして計算するため、charの符号に関係なく同じ索引になる
+TEST_CASE(SkillTable, UnsignedHash) {
+	// 符号拡張の違いはハッシュの下位8bitには現れないため、バケット数が256を超える数のスキルで確認する
+	std::vector<SkillA> Skills;
+	for (int i = 0; i < 300; i++) Skills.push_back({ "\xE3\x83\x95\xE3\x82\xA1" + std::to_string(i) + "\xFF", 0, 0, "", ElementInfo::Normal });
+	const SkillTableA Table(Skills);
+	const std::uint32_t* Data = static_cast<const std::uint32_t*>(Table.GetData());
+	const std::uint32_t BucketNum = Data[4];
+	// ヘッダーとRecord[SkillNum]の後にNameBucket[BucketNum]が続く
+	const std::uint32_t* NameBucket = Data + 8 + 7 * Skills.size();
+	std::vector<std::uint32_t> Expected(BucketNum, 0);
+	for (std::uint32_t i = 0; i < Skills.size(); i++) {
+		std::uint32_t Hash = 2166136261u;
+		for (const unsigned char c : Skills[i].Name) {
+			Hash ^= c;
+			Hash *= 16777619u;
+		}
+		std::uint32_t Bucket = Hash & (BucketNum - 1);
+		while (Expected[Bucket] != 0) Bucket = (Bucket + 1) & (BucketNum - 1);
+		Expected[Bucket] = i + 1;
+	}
+	CHECK((std::vector<std::uint32_t>(NameBucket, NameBucket + BucketNum) == Expected));
+	CHECK_EQUAL(static_cast<SkillId>(123), Table.Find("\xE3\x83\x95\xE3\x82\xA1" "123\xFF"));
+}
+
+TEST_CASE(SkillTable, Wide) {
+	const SkillTableW Table(std::vector<SkillW>{ { L"ファイア", 4, 30, L"炎", ElementInfo::Fire } });
+	CHECK(Table.GetName(Table.Find(L"ファイア")) == L"ファイア");
+}
@@ -0,0 +1,26 @@
+#include "UnitTest.hpp"
+#include <cstring>
+
+// 引数：実行するスイート名(省略した場合は全てのテストを実行する)
+int main(int argc, char* argv[]) {
+	const char* Suite = argc > 1 ? argv[1] : nullptr;
+	size_t RunNum = 0;
+	for (const UnitTest::TestCase& Test : UnitTest::GetTestList()) {
+		if (Suite != nullptr && std::strcmp(Suite, Test.Suite) != 0) continue;
+		const size_t Before = UnitTest::FailureNum;
+		try {
+			Test.Function();
+		}
+		catch (const std::exception& e) {
+			UnitTest::ReportFailure(Test.Suite, 0, std::string("unexpected exception: ") + e.what());
+		}
+		std::cout << (UnitTest::FailureNum == Before ? "[  OK  ] " : "[FAILED] ") << Test.Suite << "." << Test.Name << std::endl;
+		RunNum++;
+	}
+	if (RunNum == 0) {
+		std::cerr << "no test matched." << std::endl;
+		return 1;
+	}
+	std::cout << RunNum << " tests, " << UnitTest::FailureNum << " failures" << std::endl;
+	return UnitTest::FailureNum == 0 ? 0 : 1;
+}
@@ -0,0 +1,92 @@
+#include "UnitTest.hpp"
+#include "Text.hpp"
+#include "Number.hpp"
+#include "Element.hpp"
+#include "MasterDataLoader.hpp"
+#include "SkillTable.hpp"
+#include <string>
+#include <vector>
+
+TEST_CASE(Text, CharType) {
+	CHECK((std::is_same<standard::text_char_t<std::string>, char>::value));
+	CHECK((std::is_same<standard::text_char_t<const std::wstring&>, wchar_t>::value));
+	CHECK((std::is_same<standard::text_char_t<std::u16string_view>, char16_t>::value));
+	CHECK((std::is_same<standard::text_char_t<decltype("text")>, char>::value));
+	CHECK((std::is_same<standard::text_char_t<const char32_t*>, char32_t>::value));
+	CHECK(standard::to_string_view(L"fire") == std::wstring_view(L"fire"));
+}
+
+TEST_CASE(Text, Transcode) {
+	// ASCIIの連続部分(SIMD)と複数バイトの文字が混在する
+	const std::string Utf8 = u8"Fire,4,30,炎で攻撃する魔法です,fire\nメテオ☄️🔥,99,999,ASCII only description for the vector path,fire\n";
+	std::u16string Utf16;
+	CHECK(standard::transcode(Utf8, Utf16) == std::errc());
+	CHECK(Utf16 == u"Fire,4,30,炎で攻撃する魔法です,fire\nメテオ☄️🔥,99,999,ASCII only description for the vector path,fire\n");
+	std::u32string Utf32;
+	CHECK(standard::transcode(Utf16, Utf32) == std::errc());
+	CHECK(Utf32 == U"Fire,4,30,炎で攻撃する魔法です,fire\nメテオ☄️🔥,99,999,ASCII only description for the vector path,fire\n");
+	std::string RoundTrip;
+	CHECK(standard::transcode(Utf16, RoundTrip) == std::errc());
+	CHECK(RoundTrip == Utf8);
+	CHECK(standard::transcode(Utf32, RoundTrip) == std::errc());
+	CHECK(RoundTrip == Utf8);
+	std::wstring Wide;
+	CHECK(standard::transcode(Utf8, Wide) == std::errc());
+	CHECK(Wide == L"Fire,4,30,炎で攻撃する魔法です,fire\nメテオ☄️🔥,99,999,ASCII only description for the vector path,fire\n");
+	// UTF-32→UTF-16ではBMP外の文字が２単位になる
+	CHECK(standard::transcode(U"🔥", Utf16) == std::errc());
+	CHECK(Utf16 == u"🔥");
+	CHECK_EQUAL(2u, Utf16.size());
+	CHECK(standard::transcode(Utf32, Utf16) == std::errc());
+	CHECK(Utf16 == u"Fire,4,30,炎で攻撃する魔法です,fire\nメテオ☄️🔥,99,999,ASCII only description for the vector path,fire\n");
+	CHECK(standard::transcode(L"🔥🔥", Utf16) == std::errc());
+	CHECK(Utf16 == u"🔥🔥");
+	CHECK(standard::transcode("", Wide) == std::errc());
+	CHECK(Wide.empty());
+}
+
+TEST_CASE(Text, TranscodeInvalid) {
+	std::u16string Utf16;
+	// 冗長な表現、サロゲート、途中で切れた並び、単独の継続バイト
+	for (const char* Invalid : { "\xC0\xAF", "\xED\xA0\x80", "abcdefghijklmnopqrstuvwxyz\xE3\x81", "\x80", "\xF4\x90\x80\x80" }) {
+		Utf16 = u"not empty";
+		CHECK(standard::transcode(Invalid, Utf16) == std::errc::illegal_byte_sequence);
+		CHECK(Utf16.empty());
+	}
+	std::string Utf8;
+	CHECK(standard::transcode(std::u16string(1, char16_t(0xD800)), Utf8) == std::errc::illegal_byte_sequence);
+	CHECK(standard::transcode(std::u16string{ char16_t(0xDC00), u'a' }, Utf8) == std::errc::illegal_byte_sequence);
+	CHECK(standard::transcode(std::u32string(1, char32_t(0x110000)), Utf8) == std::errc::illegal_byte_sequence);
+}
+
+TEST_CASE(Text, UnifiedTextInput) {
+	// 文字型を問わず同じ関数で処理する
+	CHECK_EQUAL(ElementInfo::Fire, Element(std::string("fire")).Elem);
+	CHECK_EQUAL(ElementInfo::Ice, Element(L"ice").Elem);
+	CHECK_EQUAL(ElementInfo::Wind, Element(std::u16string_view(u"wind")).Elem);
+	CHECK_EQUAL(42, standard::stoi("42").Get());
+	CHECK_EQUAL(-7, standard::stoi(std::wstring(L"-7")).Get());
+	CHECK_EQUAL(1.5, standard::stod(L"1.5").Get());
+	int Value = 0;
+	CHECK(standard::parse(u"123", Value) == std::errc());
+	CHECK_EQUAL(123, Value);
+	CHECK(standard::parse(std::string("0x1"), Value) == std::errc::invalid_argument);
+	CHECK(standard::parse(std::u32string_view(U"-5"), Value) == std::errc());
+	CHECK_EQUAL(-5, Value);
+	CHECK(standard::parse(std::wstring(1, static_cast<wchar_t>(-0x30)), Value) == std::errc::invalid_argument);
+}
+
+TEST_CASE(Text, TranscodeAtLoad) {
+	// UTF-8のマスターデータを読み込み時に一度だけUTF-16へ変換し、以降はchar16_tの表で処理する
+	std::u16string Text;
+	CHECK(standard::transcode(u8"ファイア\t4\t30\t炎で攻撃\tfire\nブリザド\t6\t45\t氷で攻撃\tice\n", Text) == std::errc());
+	BasicDelimitedTextReader<char16_t> Reader(Text, u'\t');
+	std::vector<BasicSkill<char16_t>> Skills;
+	CHECK(MasterDataLoader::LoadSkills(Reader, Skills) == std::errc());
+	CHECK_EQUAL(2u, Skills.size());
+	const BasicSkillTable<char16_t> Table(Skills);
+	const SkillId Id = Table.Find(u"ブリザド");
+	CHECK(Id != SkillId::Invalid);
+	CHECK_EQUAL(45, Table.GetBasePower(Id));
+	CHECK(Table.GetDescription(Id) == u"氷で攻撃");
+}
@@ -0,0 +1,89 @@
+#include "UnitTest.hpp"
+#include "TurnScheduler.hpp"
+#include <vector>
+
+TEST_CASE(TurnScheduler, OrderBySpeed) {
+	TurnScheduler<int> Scheduler(1, 0, 0);
+	for (const int Speed : { 30, 50, 10, 50, 40 }) Scheduler.Add(SpeedManager<int>(Speed, 999, 0));
+	Scheduler.StartRound();
+	std::vector<size_t> Order;
+	for (size_t Id = Scheduler.Next(); Id != std::numeric_limits<size_t>::max(); Id = Scheduler.Next()) Order.push_back(Id);
+	// 同じ素早さの場合は番号が小さい方が先
+	CHECK((Order == std::vector<size_t>{ 1, 3, 4, 0, 2 }));
+	CHECK_EQUAL(0u, Scheduler.GetRemainingNum());
+	CHECK_EQUAL(1u, Scheduler.GetRound());
+}
+
+TEST_CASE(TurnScheduler, ChangeDuringRound) {
+	TurnScheduler<int> Scheduler(1, 0, 0);
+	for (const int Speed : { 30, 20, 10 }) Scheduler.Add(SpeedManager<int>(Speed, 999, 0));
+	Scheduler.StartRound();
+	CHECK_EQUAL(0u, Scheduler.Next());
+	Scheduler.PowerUp(2, 100);
+	Scheduler.Remove(1);
+	CHECK_EQUAL(2u, Scheduler.Next());
+	CHECK_EQUAL(std::numeric_limits<size_t>::max(), Scheduler.Next());
+	Scheduler.Reset(2);
+	Scheduler.StartRound();
+	CHECK_EQUAL(2u, Scheduler.GetRemainingNum());
+	CHECK_EQUAL(0u, Scheduler.Next());
+	CHECK_THROWS(TurnScheduler<int>(1, 0, 10));
+}
+
+// 外したキャラクターは以降のラウンドでも行動せず、戻すと次のラウンドから行動する
+TEST_CASE(TurnScheduler, RemoveAcrossRounds) {
+	TurnScheduler<int> Scheduler(1, 0, 0);
+	for (const int Speed : { 30, 20, 10, 40 }) Scheduler.Add(SpeedManager<int>(Speed, 999, 0));
+	Scheduler.Remove(3);
+	Scheduler.StartRound();
+	Scheduler.Remove(1);
+	std::vector<size_t> Order;
+	for (int Round = 0; Round < 3; Round++) {
+		for (size_t Id = Scheduler.Next(); Id != std::numeric_limits<size_t>::max(); Id = Scheduler.Next()) Order.push_back(Id);
+		Scheduler.StartRound();
+	}
+	CHECK((Order == std::vector<size_t>{ 0, 2, 0, 2, 0, 2 }));
+	CHECK(Scheduler.IsRemoved(1));
+	CHECK(!Scheduler.IsRemoved(0));
+	Scheduler.Revive(3);
+	CHECK_EQUAL(2u, Scheduler.GetRemainingNum());
+	Scheduler.StartRound();
+	CHECK_EQUAL(3u, Scheduler.GetRemainingNum());
+	CHECK_EQUAL(3u, Scheduler.Next());
+}
+
+TEST_CASE(TurnScheduler, ReproducibleWithSeed) {
+	TurnScheduler<int> First(99, 20, 0), Second(99, 20, 0);
+	for (int i = 0; i < 16; i++) {
+		First.Add(SpeedManager<int>(50 + i, 999, 0));
+		Second.Add(SpeedManager<int>(50 + i, 999, 0));
+	}
+	for (int Round = 0; Round < 10; Round++) {
+		First.StartRound();
+		Second.StartRound();
+		for (int i = 0; i < 16; i++) CHECK_EQUAL(First.Next(), Second.Next());
+	}
+}
+
+// Clearの後は、同じ引数で作り直した場合と同じ行動順になる
+TEST_CASE(TurnScheduler, Clear) {
+	TurnScheduler<int> Reused(5, 10, 0);
+	for (const int Speed : { 30, 20 }) Reused.Add(SpeedManager<int>(Speed, 999, 0));
+	Reused.Remove(0);
+	Reused.StartRound();
+	Reused.Clear(99, 20, 0);
+	CHECK_EQUAL(0u, Reused.Size());
+	CHECK_EQUAL(0u, Reused.GetRound());
+	TurnScheduler<int> Fresh(99, 20, 0);
+	for (int i = 0; i < 8; i++) {
+		Reused.Add(SpeedManager<int>(50 + i, 999, 0));
+		Fresh.Add(SpeedManager<int>(50 + i, 999, 0));
+	}
+	CHECK(!Reused.IsRemoved(0));
+	for (int Round = 0; Round < 3; Round++) {
+		Reused.StartRound();
+		Fresh.StartRound();
+		for (int i = 0; i < 8; i++) CHECK_EQUAL(Fresh.Next(), Reused.Next());
+	}
+	CHECK_THROWS(Reused.Clear(1, 0, 10));
+}
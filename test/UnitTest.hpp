@@ -0,0 +1,65 @@
+#ifndef __UNITTEST_HPP__
+#define __UNITTEST_HPP__
+#include <vector>
+#include <string>
+#include <sstream>
+#include <iostream>
+#include <type_traits>
+
+// 外部のライブラリを使用しない最小限のテストフレームワーク
+// TEST_CASE(Suite, Name)で定義したテストは自動で登録され、TestMain.cppから実行される
+namespace UnitTest {
+	struct TestCase {
+		const char* Suite;
+		const char* Name;
+		void(*Function)();
+	};
+	inline std::vector<TestCase>& GetTestList() {
+		static std::vector<TestCase> List;
+		return List;
+	}
+	inline size_t FailureNum = 0;
+	struct Registrar {
+		Registrar(const char* Suite, const char* Name, void(*Function)()) { GetTestList().push_back({ Suite, Name, Function }); }
+	};
+	inline void ReportFailure(const char* File, const int Line, const std::string& Message) {
+		FailureNum++;
+		std::cerr << File << "(" << Line << "): " << Message << std::endl;
+	}
+	template<class T, class = void>
+	struct IsPrintable : std::false_type {};
+	template<class T>
+	struct IsPrintable<T, std::void_t<decltype(std::declval<std::ostream&>() << std::declval<const T&>())>> : std::true_type {};
+	template<typename T>
+	void Print(std::ostream& Stream, const T& Value) {
+		if constexpr (std::is_enum<T>::value) Stream << +static_cast<std::underlying_type_t<T>>(Value);
+		else if constexpr (std::is_arithmetic<T>::value) Stream << +Value;
+		else if constexpr (IsPrintable<T>::value) Stream << Value;
+		else Stream << "?";
+	}
+	template<typename Expected, typename Actual>
+	void CheckEqual(const Expected& Left, const Actual& Right, const char* LeftExpression, const char* RightExpression, const char* File, const int Line) {
+		if (Left == Right) return;
+		std::ostringstream Message;
+		Message << LeftExpression << " == " << RightExpression << " failed (";
+		Print(Message, Left);
+		Message << " != ";
+		Print(Message, Right);
+		Message << ")";
+		ReportFailure(File, Line, Message.str());
+	}
+}
+
+#define TEST_CASE(Suite, Name) \
+	static void Suite##_##Name(); \
+	static const UnitTest::Registrar Suite##_##Name##_Registrar(#Suite, #Name, Suite##_##Name); \
+	static void Suite##_##Name()
+#define CHECK(Expression) ((Expression) ? (void)0 : UnitTest::ReportFailure(__FILE__, __LINE__, "CHECK(" #Expression ") failed"))
+#define CHECK_EQUAL(Expected, Actual) UnitTest::CheckEqual((Expected), (Actual), #Expected, #Actual, __FILE__, __LINE__)
+#define CHECK_THROWS(...) \
+	do { \
+		bool Thrown = false; \
+		try { __VA_ARGS__; } catch (...) { Thrown = true; } \
+		if (!Thrown) UnitTest::ReportFailure(__FILE__, __LINE__, "CHECK_THROWS(" #__VA_ARGS__ ") did not throw"); \
+	} while (false)
+#endif